@@ -1443,6 +1443,19 @@ declare global {
         getAllEntitiesOnTile(type: "staff", tilePos: CoordsXY): Staff[];
         getAllEntitiesOnTile(type: "car", tilePos: CoordsXY): Car[];
         getAllEntitiesOnTile(type: "litter", tilePos: CoordsXY): Litter[];
+
+        /**
+         * Gets the given fields of all entities of a type in one call, which is much faster than
+         * reading them from the objects returned by getAllEntities when there are many entities.
+         * Each field is returned as an Int32Array where index i belongs to the i-th entity found.
+         * @param type The type of entities to query, only "balloon", "car", "duck", "guest", "litter",
+         * "peep" and "staff" are supported.
+         * @param fields The fields to return for each entity.
+         * @param options Optionally limits the query to the entities within an area.
+         */
+        queryEntities<T extends EntityQueryField>(
+            type: EntityType, fields: T[], options?: EntityQueryOptions): EntityQueryResult<T>;
+
         createEntity(type: EntityType, initializer: object): Entity;
 
         /**
@@ -1454,6 +1467,38 @@ declare global {
         getTrackIterator(location: CoordsXY, elementIndex: number): TrackIterator | null;
     }
 
+    /**
+     * The fields that can be returned by {@link GameMap.queryEntities}. The peep fields are only available
+     * for guests and staff, the guest fields only for guests and the car fields only for cars.
+     */
+    type EntityQueryField =
+        "id" | "x" | "y" | "z" |
+        "energy" | "energyTarget" |
+        "happiness" | "happinessTarget" | "nausea" | "hunger" | "thirst" | "toilet" | "cash" | "isInPark" |
+        "ride" | "velocity";
+
+    interface EntityQueryOptions {
+        /**
+         * Only return entities within this range, in game coordinates.
+         */
+        range?: MapRange;
+
+        /**
+         * Only return entities within the given radius of this point, in game coordinates.
+         */
+        centre?: CoordsXY;
+        radius?: number;
+    }
+
+    type EntityQueryResult<T extends EntityQueryField> = {
+        [field in T]: Int32Array;
+    } & {
+        /**
+         * The number of entities found.
+         */
+        count: number;
+    };
+
     type TileElementType =
         "surface" | "footpath" | "track" | "small_scenery" | "wall" | "entrance" | "large_scenery" | "banner";
 
@@ -4856,6 +4901,15 @@ declare global {
 
     interface Profiler {
         getData(): ProfiledFunction[];
+        getCounters(): ProfiledCounter[];
+
+        /**
+         * Gets the time spent in the code of each plugin. This is always recorded, even when the
+         * profiler is not enabled. Time spent in other plugins, e.g. in action hooks run because
+         * a plugin executed an action, is accounted to those plugins.
+         */
+        getPluginData(): ProfiledPlugin[];
+
         start(): void;
         stop(): void;
         reset(): void;
@@ -4872,6 +4926,44 @@ declare global {
         readonly children: number[];
     }
 
+    interface ProfiledCounter {
+        readonly name: string;
+        readonly value: number;
+    }
+
+    interface ProfiledPluginCalls {
+        readonly callCount: number;
+        /**
+         * The time in microseconds.
+         */
+        readonly maxTime: number;
+        /**
+         * The time in microseconds.
+         */
+        readonly totalTime: number;
+    }
+
+    interface ProfiledPlugin extends ProfiledPluginCalls {
+        readonly name: string;
+
+        /**
+         * The number of ticks in which the plugin used more than the tick budget set in the config.
+         */
+        readonly overrunCount: number;
+
+        /**
+         * The number of times an interval of the plugin was delayed because it was over the tick budget.
+         */
+        readonly deferredCount: number;
+
+        readonly intervals: ProfiledPluginCalls;
+
+        /**
+         * The calls made for each hook the plugin has been called for, by hook type.
+         */
+        readonly hooks: { [hook in HookType]?: ProfiledPluginCalls };
+    }
+
     interface ObjectManager {
         /**
          * Gets all the objects that are installed and can be loaded into the park.
@@ -2558,10 +2558,14 @@ private:
             mapCoords.y = 0;
         }
 
+        // The temporary elements have to be placed on tiles that are kept in memory, use the middle of the map.
+        const auto& mapSize = OpenRCT2::GetGameState().MapSize;
+        const auto previewOrigin = TileCoordsXY{ mapSize.x / 2, mapSize.y / 2 }.ToCoordsXY();
+
         auto rotatedMapCoords = mapCoords.Rotate(trackDirection);
         // this is actually case 0, but the other cases all jump to it
-        mapCoords.x = 4112 + (rotatedMapCoords.x / 2);
-        mapCoords.y = 4112 + (rotatedMapCoords.y / 2);
+        mapCoords.x = previewOrigin.x + 16 + (rotatedMapCoords.x / 2);
+        mapCoords.y = previewOrigin.y + 16 + (rotatedMapCoords.y / 2);
         mapCoords.z = 1024 + mapCoords.z;
 
         auto previewZOffset = ted.Definition.PreviewZOffset;
@@ -2572,7 +2576,7 @@ private:
         dpi.x += rotatedScreenCoords.x - widgetWidth / 2;
         dpi.y += rotatedScreenCoords.y - widgetHeight / 2 - 16;
 
-        DrawTrackPieceHelper(dpi, rideIndex, trackType, trackDirection, liftHillAndInvertedState, { 4096, 4096 }, 1024);
+        DrawTrackPieceHelper(dpi, rideIndex, trackType, trackDirection, liftHillAndInvertedState, previewOrigin, 1024);
     }
 
     void DrawTrackPieceHelper(
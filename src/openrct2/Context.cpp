@@ -183,6 +183,7 @@ namespace OpenRCT2
 #endif
 
             GameActions::ClearQueue();
+            GameAutosaveWait();
 #ifndef DISABLE_NETWORK
             _network.Close();
 #endif
@@ -298,6 +299,10 @@ namespace OpenRCT2
             if (Initialise())
             {
                 Launch();
+                if (!gProfilerTracePath.empty() && !Profiling::ExportChromeTrace(gProfilerTracePath))
+                {
+                    LOG_ERROR("Unable to write profiler trace to %s", gProfilerTracePath.c_str());
+                }
                 return EXIT_SUCCESS;
             }
             return EXIT_FAILURE;
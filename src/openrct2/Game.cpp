@@ -27,6 +27,7 @@
 #include "core/Console.hpp"
 #include "core/File.h"
 #include "core/FileScanner.h"
+#include "core/MemoryStream.h"
 #include "core/Path.hpp"
 #include "entity/EntityRegistry.h"
 #include "entity/PatrolArea.h"
@@ -71,7 +72,9 @@
 #include "world/Surface.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <future>
 #include <iterator>
 #include <memory>
 
@@ -450,9 +453,10 @@ static void FixInvalidSurfaces()
     // Fixes broken saves where a surface element could be null
     // and broken saves with incorrect invisible map border tiles
 
-    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    const auto& mapSize = GetGameState().MapSize;
+    for (int32_t y = 0; y < mapSize.y; y++)
     {
-        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        for (int32_t x = 0; x < mapSize.x; x++)
         {
             auto* surfaceElement = MapGetSurfaceElementAt(TileCoordsXY{ x, y });
 
@@ -675,6 +679,8 @@ void SaveGameAs()
     ContextOpenIntent(intent.get());
 }
 
+static std::future<void> _autosaveFuture;
+
 static void LimitAutosaveCount(const size_t numberOfFilesToKeep, bool processLandscapeFolder)
 {
     size_t autosavesCount = 0;
@@ -756,25 +762,71 @@ void GameAutosave()
         currentDate.day, currentTime.hour, currentTime.minute, currentTime.second, fileExtension);
 
     int32_t autosavesToKeep = gConfigGeneral.AutosaveAmount;
-    LimitAutosaveCount(autosavesToKeep - 1, (gScreenFlags & SCREEN_FLAGS_EDITOR));
+    bool processLandscapeFolder = (gScreenFlags & SCREEN_FLAGS_EDITOR) != 0;
 
     auto env = GetContext()->GetPlatformEnvironment();
     auto autosaveDir = Path::Combine(env->GetDirectoryPath(DIRBASE::USER, subDirectory), u8"autosave");
-    Path::CreateDirectory(autosaveDir);
 
     auto path = Path::Combine(autosaveDir, timeName);
     auto backupFileName = u8string(u8"autosave") + fileExtension + u8".bak";
     auto backupPath = Path::Combine(autosaveDir, backupFileName);
 
-    if (File::Exists(path))
+    // Only one autosave is written at a time, never block the game thread on the previous one.
+    if (GameAutosaveIsPending())
     {
-        File::Copy(path, backupPath, true);
+        LOG_VERBOSE("Previous autosave is still being written, skipping");
+        return;
     }
+    GameAutosaveWait();
 
+    // Exporting the park is the part of the autosave that still runs on the game thread.
+    const auto snapshotStart = std::chrono::steady_clock::now();
+    MemoryStream snapshot;
     auto& gameState = GetGameState();
+    if (!ScenarioSaveSnapshot(gameState, snapshot, saveFlags))
+    {
+        Console::Error::WriteLine("Could not autosave the scenario.");
+        return;
+    }
+    const auto snapshotMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - snapshotStart)
+                                .count();
+    LOG_VERBOSE("Autosave snapshot of %zu bytes took %.2f ms", static_cast<size_t>(snapshot.GetLength()), snapshotMs);
+
+    // Compressing and writing the snapshot does not touch the game state, so the game can continue meanwhile.
+    _autosaveFuture = std::async(
+        std::launch::async,
+        [snapshot = std::move(snapshot), autosavesToKeep, processLandscapeFolder, autosaveDir, path, backupPath]() mutable {
+            LimitAutosaveCount(autosavesToKeep - 1, processLandscapeFolder);
+            Path::CreateDirectory(autosaveDir);
+
+            if (File::Exists(path))
+            {
+                File::Copy(path, backupPath, true);
+            }
+
+            if (!ScenarioWriteSnapshot(snapshot, path))
+                Console::Error::WriteLine("Could not autosave the scenario. Is the save folder writeable?");
+        });
+}
 
-    if (!ScenarioSave(gameState, path, saveFlags))
-        Console::Error::WriteLine("Could not autosave the scenario. Is the save folder writeable?");
+bool GameAutosaveIsPending()
+{
+    return _autosaveFuture.valid() && _autosaveFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void GameAutosaveWait()
+{
+    if (_autosaveFuture.valid())
+    {
+        try
+        {
+            _autosaveFuture.get();
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Could not autosave the scenario: %s", e.what());
+        }
+    }
 }
 
 static void GameLoadOrQuitNoSavePromptCallback(int32_t result, const utf8* path)
@@ -172,6 +172,8 @@ void SaveGameAs();
 void SaveGameCmd(u8string_view name = {});
 void SaveGameWithName(u8string_view name);
 void GameAutosave();
+bool GameAutosaveIsPending();
+void GameAutosaveWait();
 void RCT2StringToUTF8Self(char* buffer, size_t length);
 void GameFixSaveVars();
 void StartSilentRecord();
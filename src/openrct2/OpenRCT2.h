@@ -49,6 +49,7 @@ extern bool gOpenRCT2NoGraphics;
 extern bool gOpenRCT2ShowChangelog;
 extern bool gOpenRCT2SilentBreakpad;
 extern u8string gSilentRecordingName;
+extern u8string gProfilerTracePath;
 
 #ifndef DISABLE_NETWORK
 extern int32_t gNetworkStart;
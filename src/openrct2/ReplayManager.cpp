@@ -25,6 +25,8 @@
 #include "actions/TrackPlaceAction.h"
 #include "config/Config.h"
 #include "core/DataSerialiser.h"
+#include "core/File.h"
+#include "core/FileStream.h"
 #include "core/Path.hpp"
 #include "entity/EntityRegistry.h"
 #include "entity/EntityTweener.h"
@@ -32,11 +34,14 @@
 #include "object/ObjectManager.h"
 #include "object/ObjectRepository.h"
 #include "park/ParkFile.h"
+#include "profiling/Profiling.h"
 #include "scenario/Scenario.h"
 #include "world/Park.h"
 #include "zlib.h"
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -71,6 +76,36 @@ namespace OpenRCT2
         }
     };
 
+    /**
+     * Replays are written as a stream of blocks, each compressed on its own, so a recording can be appended to as the game
+     * runs and a replay that was cut short is still readable up to its last complete block.
+     */
+    enum class ReplayBlockType : uint8_t
+    {
+        Header,
+        Keyframe,
+        Commands,
+        Checksums,
+        End,
+    };
+
+    struct ReplayBlock
+    {
+        ReplayBlockType type;
+        // The tick of a keyframe, or the tick the block was written at.
+        uint32_t tick;
+        OpenRCT2::MemoryStream data;
+    };
+
+    struct ReplayKeyframe
+    {
+        uint32_t tick;
+        // Position of the keyframe block in the replay file, or kInitialKeyframe for the park data of the replay.
+        uint64_t filePosition;
+    };
+
+    static constexpr uint64_t kInitialKeyframe = std::numeric_limits<uint64_t>::max();
+
     struct ReplayRecordFile
     {
         uint32_t magic;
@@ -92,17 +127,30 @@ namespace OpenRCT2
         uint64_t timeRecorded; // Posix Time.
         uint32_t tickStart;    // First tick of replay.
         uint32_t tickEnd;      // Last tick of replay.
+        uint32_t firstCommandIndex; // Index of the first command after the park data was taken.
         std::multiset<ReplayCommand> commands;
+        std::multiset<ReplayCommand>::iterator nextCommand;
         std::vector<std::pair<uint32_t, EntitiesChecksum>> checksums;
         uint32_t checksumIndex;
         OpenRCT2::MemoryStream gameStateSnapshots;
+        std::vector<ReplayKeyframe> keyframes;
+
+        // While recording, commands and checksums are only kept until they are written to the file.
+        std::unique_ptr<OpenRCT2::FileStream> file;
+        uint32_t numCommands;
+        uint32_t numChecksums;
+        uint32_t nextFlushTick;
+        uint32_t nextKeyframeTick;
+        uint32_t keyframeTicks;
     };
 
     class ReplayManager final : public IReplayManager
     {
-        static constexpr uint16_t ReplayVersion = 10;
+        static constexpr uint16_t ReplayVersion = 11;
+        static constexpr uint16_t LegacyReplayVersion = 10; // Whole replay compressed at once.
         static constexpr uint32_t ReplayMagic = 0x5243524F; // ORCR.
         static constexpr int ReplayCompressionLevel = 9;
+        static constexpr uint32_t FlushTicks = 40 * 30;
         static constexpr int NormalRecordingChecksumTicks = 1;
         static constexpr int SilentRecordingChecksumTicks = 40; // Same as network server
 
@@ -147,11 +195,13 @@ namespace OpenRCT2
             auto ga = GameActions::Clone(action);
 
             _currentRecording->commands.emplace(tick, std::move(ga), _commandId++);
+            _currentRecording->numCommands++;
         }
 
         void AddChecksum(uint32_t tick, EntitiesChecksum&& checksum)
         {
             _currentRecording->checksums.emplace_back(std::make_pair(tick, std::move(checksum)));
+            _currentRecording->numChecksums++;
         }
 
         // Function runs each Tick.
@@ -170,6 +220,25 @@ namespace OpenRCT2
                 _nextChecksumTick = currentTicks + ChecksumTicksDelta();
             }
 
+            if (_mode == ReplayMode::RECORDING || _mode == ReplayMode::NORMALISATION)
+            {
+                if (currentTicks >= _currentRecording->nextKeyframeTick)
+                {
+                    WriteKeyframe(*_currentRecording, currentTicks);
+                }
+                else if (currentTicks >= _currentRecording->nextFlushTick)
+                {
+                    try
+                    {
+                        FlushRecording(*_currentRecording, currentTicks);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        LOG_ERROR("Unable to write to file '%s': %s", _currentRecording->filePath.c_str(), e.what());
+                    }
+                }
+            }
+
             if (_mode == ReplayMode::RECORDING)
             {
                 if (currentTicks >= _currentRecording->tickEnd)
@@ -199,7 +268,7 @@ namespace OpenRCT2
                 ReplayCommands();
 
                 // If we run out of commands we can just stop
-                if (_currentReplay->commands.empty())
+                if (_currentReplay->nextCommand == _currentReplay->commands.end())
                 {
                     StopPlayback();
                     StopRecording();
@@ -223,7 +292,8 @@ namespace OpenRCT2
         }
 
         virtual bool StartRecording(
-            const std::string& name, uint32_t maxTicks /*= k_MaxReplayTicks*/, RecordType rt /*= RecordType::NORMAL*/) override
+            const std::string& name, uint32_t maxTicks /*= k_MaxReplayTicks*/, RecordType rt /*= RecordType::NORMAL*/,
+            uint32_t keyframeTicks /*= k_ReplayKeyframeTicks*/) override
         {
             // If using silent recording, discard whatever recording there is going on, even if a new silent recording is to be
             // started.
@@ -247,26 +317,30 @@ namespace OpenRCT2
                 replayData->tickEnd = k_MaxReplayTicks;
 
             replayData->filePath = name;
-
-            auto context = GetContext();
-            auto& objManager = context->GetObjectManager();
-            auto objects = objManager.GetPackableObjects();
-
-            auto& gameState = GetGameState();
-            auto exporter = std::make_unique<ParkFileExporter>();
-            exporter->ExportObjectsList = objects;
-            exporter->Export(gameState, replayData->parkData);
-
             replayData->timeRecorded = std::chrono::seconds(std::time(nullptr)).count();
+            replayData->firstCommandIndex = _commandId;
 
-            DataSerialiser parkParamsDs(true, replayData->parkParams);
-            SerialiseParkParameters(parkParamsDs);
+            ExportPark(replayData->parkData, replayData->parkParams);
 
             DataSerialiser cheatDataDs(true, replayData->cheatData);
             SerialiseCheats(cheatDataDs);
 
             TakeGameStateSnapshot(replayData->gameStateSnapshots);
 
+            try
+            {
+                replayData->file = std::make_unique<FileStream>(replayData->filePath, FILE_MODE_WRITE);
+                WriteReplayHeader(*replayData);
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Unable to write to file '%s': %s", replayData->filePath.c_str(), e.what());
+                return false;
+            }
+            replayData->nextFlushTick = currentTicks + FlushTicks;
+            replayData->keyframeTicks = std::max<uint32_t>(keyframeTicks, 1);
+            replayData->nextKeyframeTick = currentTicks + replayData->keyframeTicks;
+
             if (_mode != ReplayMode::NORMALISATION)
                 _mode = ReplayMode::RECORDING;
 
@@ -284,7 +358,9 @@ namespace OpenRCT2
 
             if (discard)
             {
+                const auto filePath = _currentRecording->filePath;
                 _currentRecording.reset();
+                File::Delete(filePath);
                 _mode = ReplayMode::NONE;
                 return true;
             }
@@ -298,49 +374,24 @@ namespace OpenRCT2
                 AddChecksum(currentTicks, std::move(checksum));
             }
 
-            TakeGameStateSnapshot(_currentRecording->gameStateSnapshots);
-
-            // Serialise Body.
-            DataSerialiser recSerialiser(true);
-            Serialise(recSerialiser, *_currentRecording);
-
-            const auto& stream = recSerialiser.GetStream();
-            unsigned long streamLength = static_cast<unsigned long>(stream.GetLength());
-            unsigned long compressLength = compressBound(streamLength);
-
-            MemoryStream data(compressLength);
-
-            ReplayRecordFile file{ _currentRecording->magic, _currentRecording->version, streamLength, data };
-
-            auto compressBuf = std::make_unique<unsigned char[]>(compressLength);
-            compress2(
-                compressBuf.get(), &compressLength, static_cast<const unsigned char*>(stream.GetData()), stream.GetLength(),
-                ReplayCompressionLevel);
-            file.data.Write(compressBuf.get(), compressLength);
-
-            DataSerialiser fileSerialiser(true);
-            fileSerialiser << file.magic;
-            fileSerialiser << file.version;
-            fileSerialiser << file.uncompressedSize;
-            fileSerialiser << file.data;
-
             bool result = false;
-
-            const std::string& outFile = _currentRecording->filePath;
-
-            FILE* fp = fopen(outFile.c_str(), "wb");
-            if (fp != nullptr)
+            try
             {
-                const auto& fileStream = fileSerialiser.GetStream();
-                fwrite(fileStream.GetData(), 1, fileStream.GetLength(), fp);
-                fclose(fp);
+                FlushRecording(*_currentRecording, currentTicks);
+
+                MemoryStream endData;
+                DataSerialiser endDs(true, endData);
+                endDs << _currentRecording->tickEnd;
+                MemoryStream snapshot;
+                TakeGameStateSnapshot(snapshot);
+                endDs << snapshot;
+                WriteBlock(*_currentRecording->file, ReplayBlockType::End, currentTicks, endData);
 
                 result = true;
             }
-            else
+            catch (const std::exception& e)
             {
-                LOG_ERROR("Unable to write to file '%s'", outFile.c_str());
-                result = false;
+                LOG_ERROR("Unable to write to file '%s': %s", _currentRecording->filePath.c_str(), e.what());
             }
 
             // When normalizing the output we don't touch the mode.
@@ -377,8 +428,8 @@ namespace OpenRCT2
                 info.Ticks = GetGameState().CurrentTicks - data->tickStart;
             else if (_mode == ReplayMode::PLAYING)
                 info.Ticks = data->tickEnd - data->tickStart;
-            info.NumCommands = static_cast<uint32_t>(data->commands.size());
-            info.NumChecksums = static_cast<uint32_t>(data->checksums.size());
+            info.NumCommands = data->numCommands;
+            info.NumChecksums = data->numChecksums;
 
             return true;
         }
@@ -437,7 +488,7 @@ namespace OpenRCT2
                 return false;
             }
 
-            if (!LoadReplayDataMap(*replayData))
+            if (!LoadReplayDataMap(replayData->parkData, replayData->parkParams))
             {
                 LOG_ERROR("Unable to load map.");
                 return false;
@@ -448,6 +499,7 @@ namespace OpenRCT2
             LoadAndCompareSnapshot(replayData->gameStateSnapshots);
 
             _currentReplay = std::move(replayData);
+            _currentReplay->nextCommand = _currentReplay->commands.begin();
             _currentReplay->checksumIndex = 0;
             _faultyChecksumIndex = -1;
 
@@ -460,6 +512,38 @@ namespace OpenRCT2
             return true;
         }
 
+        virtual bool SeekPlayback(uint32_t replayTick) override
+        {
+            if (_mode != ReplayMode::PLAYING)
+                return false;
+
+            auto& replay = *_currentReplay;
+            const auto tick = replay.tickStart + std::min(replayTick, replay.tickEnd - replay.tickStart);
+
+            // Load the last keyframe before the tick, unless playback is already between it and the tick.
+            auto it = std::upper_bound(
+                replay.keyframes.begin(), replay.keyframes.end(), tick,
+                [](uint32_t value, const ReplayKeyframe& keyframe) { return value < keyframe.tick; });
+            const auto& keyframe = *std::prev(it);
+
+            const auto currentTicks = GetGameState().CurrentTicks;
+            if (tick < currentTicks || keyframe.tick > currentTicks)
+            {
+                if (!LoadKeyframe(replay, keyframe))
+                {
+                    LOG_ERROR("Unable to load the keyframe at tick %u.", keyframe.tick);
+                    return false;
+                }
+            }
+
+            auto* gameState = GetContext()->GetGameState();
+            while (_mode == ReplayMode::PLAYING && GetGameState().CurrentTicks < tick)
+            {
+                gameState->UpdateLogic();
+            }
+            return true;
+        }
+
         virtual bool IsPlaybackStateMismatching() const override
         {
             return _faultyChecksumIndex != -1;
@@ -470,7 +554,10 @@ namespace OpenRCT2
             if (_mode != ReplayMode::PLAYING && _mode != ReplayMode::NORMALISATION)
                 return false;
 
-            LoadAndCompareSnapshot(_currentReplay->gameStateSnapshots);
+            // Replays that were cut short have no final snapshot.
+            auto& snapshots = _currentReplay->gameStateSnapshots;
+            if (snapshots.GetPosition() < snapshots.GetLength())
+                LoadAndCompareSnapshot(snapshots);
 
             // During normal playback we pause the game if stopped.
             if (_mode == ReplayMode::PLAYING)
@@ -499,7 +586,7 @@ namespace OpenRCT2
                 return false;
             }
 
-            if (!StartRecording(outFile, k_MaxReplayTicks, RecordType::NORMAL))
+            if (!StartRecording(outFile, k_MaxReplayTicks, RecordType::NORMAL, k_ReplayKeyframeTicks))
             {
                 StopPlayback();
                 return false;
@@ -523,17 +610,29 @@ namespace OpenRCT2
             }
         }
 
-        bool LoadReplayDataMap(ReplayRecordData& data)
+        void ExportPark(MemoryStream& parkData, MemoryStream& parkParams)
+        {
+            auto& objManager = GetContext()->GetObjectManager();
+            auto exporter = std::make_unique<ParkFileExporter>();
+            exporter->ExportObjectsList = objManager.GetPackableObjects();
+            exporter->Export(GetGameState(), parkData);
+
+            DataSerialiser parkParamsDs(true, parkParams);
+            SerialiseParkParameters(parkParamsDs);
+        }
+
+        bool LoadReplayDataMap(MemoryStream& parkData, MemoryStream& parkParams)
         {
             try
             {
-                data.parkData.SetPosition(0);
+                parkData.SetPosition(0);
+                parkParams.SetPosition(0);
 
                 auto context = GetContext();
                 auto& objManager = context->GetObjectManager();
                 auto importer = ParkImporter::CreateParkFile(context->GetObjectRepository());
 
-                auto loadResult = importer->LoadFromStream(&data.parkData, false);
+                auto loadResult = importer->LoadFromStream(&parkData, false);
                 objManager.LoadObjects(loadResult.RequiredObjects);
 
                 // TODO: Have a separate GameState and exchange once loaded.
@@ -543,7 +642,7 @@ namespace OpenRCT2
                 EntityTweener::Get().Reset();
 
                 // Load all map global variables.
-                DataSerialiser parkParamsDs(false, data.parkParams);
+                DataSerialiser parkParamsDs(false, parkParams);
                 SerialiseParkParameters(parkParamsDs);
 
                 GameLoadInit();
@@ -612,8 +711,6 @@ namespace OpenRCT2
 
         bool ReadReplayData(const std::string& file, ReplayRecordData& data)
         {
-            MemoryStream stream;
-
             std::string fileName = file;
             if (fileName.size() < 5 || fileName.substr(fileName.size() - 5) != ".parkrep")
             {
@@ -623,18 +720,39 @@ namespace OpenRCT2
             std::string outPath = GetContext()->GetPlatformEnvironment()->GetDirectoryPath(DIRBASE::USER, DIRID::REPLAY);
             std::string outFile = Path::Combine(outPath, fileName);
 
-            bool loaded = false;
-            if (ReadReplayFromFile(outFile, stream))
-            {
+            if (File::Exists(outFile))
                 data.filePath = outFile;
-                loaded = true;
+            else if (File::Exists(file))
+                data.filePath = file;
+            else
+                return false;
+
+            try
+            {
+                FileStream fileStream(data.filePath, FILE_MODE_OPEN);
+                DataSerialiser fileSerialiser(false, fileStream);
+                uint32_t magic = 0;
+                uint16_t version = 0;
+                fileSerialiser << magic;
+                fileSerialiser << version;
+                if (magic == ReplayMagic && version == ReplayVersion)
+                {
+                    return ReadStreamedReplayData(fileStream, data);
+                }
             }
-            else if (ReadReplayFromFile(file, stream))
+            catch (const std::exception& e)
             {
-                data.filePath = file;
-                loaded = true;
+                LOG_ERROR("Unable to read replay '%s': %s", data.filePath.c_str(), e.what());
+                return false;
             }
-            if (!loaded)
+
+            return ReadLegacyReplayData(data);
+        }
+
+        bool ReadLegacyReplayData(ReplayRecordData& data)
+        {
+            MemoryStream stream;
+            if (!ReadReplayFromFile(data.filePath, stream))
                 return false;
 
             if (!TryDecompress(stream))
@@ -653,6 +771,310 @@ namespace OpenRCT2
             data.cheatData.SetPosition(0);
             data.gameStateSnapshots.SetPosition(0);
 
+            data.firstCommandIndex = 0;
+            data.keyframes = { { data.tickStart, kInitialKeyframe } };
+            data.numCommands = static_cast<uint32_t>(data.commands.size());
+            data.numChecksums = static_cast<uint32_t>(data.checksums.size());
+            return true;
+        }
+
+        bool ReadStreamedReplayData(FileStream& fileStream, ReplayRecordData& data)
+        {
+            data.magic = ReplayMagic;
+            data.version = ReplayVersion;
+            data.tickEnd = 0;
+
+            bool hasHeader = false;
+            bool hasEnd = false;
+            ReplayBlock block;
+            while (true)
+            {
+                const auto position = fileStream.GetPosition();
+                if (!ReadBlock(fileStream, block))
+                    break;
+
+                DataSerialiser ds(false, block.data);
+                switch (block.type)
+                {
+                    case ReplayBlockType::Header:
+                    {
+                        ds << data.networkId;
+                        ds << data.name;
+                        ds << data.timeRecorded;
+                        ds << data.tickStart;
+                        ds << data.cheatData;
+                        MemoryStream snapshot;
+                        ds << snapshot;
+                        data.gameStateSnapshots.Write(snapshot.GetData(), snapshot.GetLength());
+                        hasHeader = true;
+                        break;
+                    }
+                    case ReplayBlockType::Keyframe:
+                        // Only the first keyframe is loaded straight away, the others are read when seeking to them.
+                        if (data.keyframes.empty())
+                        {
+                            ds << data.firstCommandIndex;
+                            ds << data.parkData;
+                            ds << data.parkParams;
+                            data.keyframes.push_back({ block.tick, kInitialKeyframe });
+                        }
+                        else
+                        {
+                            data.keyframes.push_back({ block.tick, position });
+                        }
+                        break;
+                    case ReplayBlockType::Commands:
+                    {
+                        uint32_t countCommands = 0;
+                        ds << countCommands;
+                        for (uint32_t i = 0; i < countCommands; i++)
+                        {
+                            ReplayCommand command = {};
+                            SerialiseCommand(ds, command);
+                            data.commands.emplace(std::move(command));
+                        }
+                        break;
+                    }
+                    case ReplayBlockType::Checksums:
+                    {
+                        uint32_t countChecksums = 0;
+                        ds << countChecksums;
+                        for (uint32_t i = 0; i < countChecksums; i++)
+                        {
+                            auto& checksum = data.checksums.emplace_back();
+                            ds << checksum.first;
+                            ds << checksum.second.raw;
+                        }
+                        break;
+                    }
+                    case ReplayBlockType::End:
+                    {
+                        ds << data.tickEnd;
+                        MemoryStream snapshot;
+                        ds << snapshot;
+                        data.gameStateSnapshots.Write(snapshot.GetData(), snapshot.GetLength());
+                        hasEnd = true;
+                        break;
+                    }
+                }
+
+                // A replay that was cut short ends with its last complete block.
+                if (!hasEnd)
+                    data.tickEnd = std::max(data.tickEnd, block.tick);
+            }
+
+            if (!hasHeader || data.keyframes.empty())
+                return false;
+
+#ifndef DISABLE_NETWORK
+            // NOTE: This does not mean the replay will not function, only a warning.
+            if (data.networkId != NetworkGetVersion())
+            {
+                LOG_WARNING(
+                    "Replay network version mismatch: '%s', expected: '%s'", data.networkId.c_str(),
+                    NetworkGetVersion().c_str());
+            }
+#endif
+
+            data.parkData.SetPosition(0);
+            data.parkParams.SetPosition(0);
+            data.cheatData.SetPosition(0);
+            data.gameStateSnapshots.SetPosition(0);
+            data.numCommands = static_cast<uint32_t>(data.commands.size());
+            data.numChecksums = static_cast<uint32_t>(data.checksums.size());
+            return true;
+        }
+
+        void WriteBlock(IStream& stream, ReplayBlockType type, uint32_t tick, const MemoryStream& data)
+        {
+            unsigned long compressLength = compressBound(static_cast<unsigned long>(data.GetLength()));
+            auto compressBuf = std::make_unique<unsigned char[]>(compressLength);
+            compress2(
+                compressBuf.get(), &compressLength, static_cast<const unsigned char*>(data.GetData()), data.GetLength(),
+                ReplayCompressionLevel);
+
+            DataSerialiser ds(true, stream);
+            uint8_t blockType = EnumValue(type);
+            uint32_t uncompressedSize = static_cast<uint32_t>(data.GetLength());
+            uint32_t compressedSize = static_cast<uint32_t>(compressLength);
+            ds << blockType;
+            ds << tick;
+            ds << uncompressedSize;
+            ds << compressedSize;
+            stream.Write(compressBuf.get(), compressLength);
+        }
+
+        /**
+         * Returns false at the end of the stream or if the block was not written completely.
+         */
+        bool ReadBlock(IStream& stream, ReplayBlock& block)
+        {
+            constexpr uint64_t headerSize = sizeof(uint8_t) + 3 * sizeof(uint32_t);
+            if (stream.GetLength() - stream.GetPosition() < headerSize)
+                return false;
+
+            DataSerialiser ds(false, stream);
+            uint8_t blockType = 0;
+            uint32_t uncompressedSize = 0;
+            uint32_t compressedSize = 0;
+            ds << blockType;
+            ds << block.tick;
+            ds << uncompressedSize;
+            ds << compressedSize;
+            if (stream.GetLength() - stream.GetPosition() < compressedSize)
+                return false;
+
+            auto compressBuf = std::make_unique<unsigned char[]>(compressedSize);
+            stream.Read(compressBuf.get(), compressedSize);
+
+            std::vector<uint8_t> data(uncompressedSize);
+            unsigned long outSize = uncompressedSize;
+            if (uncompress(data.data(), &outSize, compressBuf.get(), compressedSize) != Z_OK || outSize != uncompressedSize)
+                return false;
+
+            block.type = static_cast<ReplayBlockType>(blockType);
+            block.data = MemoryStream(std::move(data));
+            return true;
+        }
+
+        void WriteReplayHeader(ReplayRecordData& data)
+        {
+            auto& stream = *data.file;
+            DataSerialiser fileSerialiser(true, stream);
+            fileSerialiser << data.magic;
+            fileSerialiser << data.version;
+
+            MemoryStream header;
+            DataSerialiser ds(true, header);
+            ds << data.networkId;
+            ds << data.name;
+            ds << data.timeRecorded;
+            ds << data.tickStart;
+            ds << data.cheatData;
+            ds << data.gameStateSnapshots;
+            WriteBlock(stream, ReplayBlockType::Header, data.tickStart, header);
+
+            MemoryStream keyframe;
+            DataSerialiser keyframeDs(true, keyframe);
+            keyframeDs << data.firstCommandIndex;
+            keyframeDs << data.parkData;
+            keyframeDs << data.parkParams;
+            WriteBlock(stream, ReplayBlockType::Keyframe, data.tickStart, keyframe);
+
+            // Everything needed later is in the file now.
+            data.parkData = MemoryStream();
+            data.parkParams = MemoryStream();
+            data.gameStateSnapshots = MemoryStream();
+        }
+
+        // Writes the commands and checksums recorded since the last flush.
+        void FlushRecording(ReplayRecordData& data, uint32_t tick)
+        {
+            data.nextFlushTick = tick + FlushTicks;
+
+            auto& stream = *data.file;
+            if (!data.commands.empty())
+            {
+                MemoryStream commands;
+                DataSerialiser ds(true, commands);
+                uint32_t countCommands = static_cast<uint32_t>(data.commands.size());
+                ds << countCommands;
+                for (auto& command : data.commands)
+                {
+                    SerialiseCommand(ds, const_cast<ReplayCommand&>(command));
+                }
+                WriteBlock(stream, ReplayBlockType::Commands, tick, commands);
+                data.commands.clear();
+            }
+
+            if (!data.checksums.empty())
+            {
+                MemoryStream checksums;
+                DataSerialiser ds(true, checksums);
+                uint32_t countChecksums = static_cast<uint32_t>(data.checksums.size());
+                ds << countChecksums;
+                for (auto& checksum : data.checksums)
+                {
+                    ds << checksum.first;
+                    ds << checksum.second.raw;
+                }
+                WriteBlock(stream, ReplayBlockType::Checksums, tick, checksums);
+                data.checksums.clear();
+            }
+        }
+
+        void WriteKeyframe(ReplayRecordData& data, uint32_t tick)
+        {
+            PROFILED_FUNCTION();
+
+            try
+            {
+                // Commands before the keyframe must be in the file before it.
+                FlushRecording(data, tick);
+
+                MemoryStream keyframe;
+                DataSerialiser ds(true, keyframe);
+                MemoryStream parkData;
+                MemoryStream parkParams;
+                ExportPark(parkData, parkParams);
+                uint32_t firstCommandIndex = _commandId;
+                ds << firstCommandIndex;
+                ds << parkData;
+                ds << parkParams;
+                WriteBlock(*data.file, ReplayBlockType::Keyframe, tick, keyframe);
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Unable to write to file '%s': %s", data.filePath.c_str(), e.what());
+            }
+            data.nextKeyframeTick = tick + data.keyframeTicks;
+        }
+
+        bool LoadKeyframe(ReplayRecordData& data, const ReplayKeyframe& keyframe)
+        {
+            uint32_t firstCommandIndex = data.firstCommandIndex;
+            if (keyframe.filePosition == kInitialKeyframe)
+            {
+                if (!LoadReplayDataMap(data.parkData, data.parkParams))
+                    return false;
+            }
+            else
+            {
+                MemoryStream parkData;
+                MemoryStream parkParams;
+                try
+                {
+                    FileStream fileStream(data.filePath, FILE_MODE_OPEN);
+                    fileStream.SetPosition(keyframe.filePosition);
+
+                    ReplayBlock block;
+                    if (!ReadBlock(fileStream, block) || block.type != ReplayBlockType::Keyframe)
+                        return false;
+
+                    DataSerialiser ds(false, block.data);
+                    ds << firstCommandIndex;
+                    ds << parkData;
+                    ds << parkParams;
+                }
+                catch (const std::exception& e)
+                {
+                    LOG_ERROR("Unable to read replay '%s': %s", data.filePath.c_str(), e.what());
+                    return false;
+                }
+                if (!LoadReplayDataMap(parkData, parkParams))
+                    return false;
+            }
+
+            GetGameState().CurrentTicks = keyframe.tick;
+
+            // Commands of the keyframe tick that were executed before it was taken are part of the park already.
+            data.nextCommand = data.commands.lower_bound(ReplayCommand(keyframe.tick, nullptr, firstCommandIndex));
+            auto checksum = std::lower_bound(
+                data.checksums.begin(), data.checksums.end(), keyframe.tick,
+                [](const std::pair<uint32_t, EntitiesChecksum>& item, uint32_t value) { return item.first < value; });
+            data.checksumIndex = static_cast<uint32_t>(std::distance(data.checksums.begin(), checksum));
+            _faultyChecksumIndex = -1;
+            gGamePaused = 0;
             return true;
         }
 
@@ -718,7 +1140,7 @@ namespace OpenRCT2
 
         bool Compatible(ReplayRecordData& data)
         {
-            return data.version == ReplayVersion;
+            return data.version == LegacyReplayVersion;
         }
 
         bool Serialise(DataSerialiser& serialiser, ReplayRecordData& data)
@@ -835,12 +1257,13 @@ namespace OpenRCT2
         void ReplayCommands()
         {
             auto& replayQueue = _currentReplay->commands;
+            auto& nextCommand = _currentReplay->nextCommand;
 
             const auto currentTicks = GetGameState().CurrentTicks;
 
-            while (replayQueue.begin() != replayQueue.end())
+            while (nextCommand != replayQueue.end())
             {
-                const ReplayCommand& command = (*replayQueue.begin());
+                const ReplayCommand& command = *nextCommand;
 
                 if (_mode == ReplayMode::PLAYING)
                 {
@@ -876,7 +1299,8 @@ namespace OpenRCT2
                         WindowScrollToLocation(*mainWindow, result.Position);
                 }
 
-                replayQueue.erase(replayQueue.begin());
+                // Commands are kept so playback can seek back to them.
+                nextCommand++;
             }
         }
 
@@ -20,6 +20,7 @@ class GameAction;
 namespace OpenRCT2
 {
     static constexpr uint32_t k_MaxReplayTicks = 0xFFFFFFFF;
+    static constexpr uint32_t k_ReplayKeyframeTicks = 40 * 60 * 5; // Ticks between keyframes of a recording.
 
     struct ReplayRecordInfo
     {
@@ -53,12 +54,16 @@ namespace OpenRCT2
         virtual void AddGameAction(uint32_t tick, const GameAction* action) = 0;
 
         virtual bool StartRecording(
-            const std::string& name, uint32_t maxTicks = k_MaxReplayTicks, RecordType rt = RecordType::NORMAL)
+            const std::string& name, uint32_t maxTicks = k_MaxReplayTicks, RecordType rt = RecordType::NORMAL,
+            uint32_t keyframeTicks = k_ReplayKeyframeTicks)
             = 0;
         virtual bool StopRecording(bool discard = false) = 0;
         virtual bool GetCurrentReplayInfo(ReplayRecordInfo& info) const = 0;
 
         virtual bool StartPlayback(const std::string& file) = 0;
+        // Continues playback from the given number of ticks after the start of the replay, loading the last keyframe
+        // before it first if needed.
+        virtual bool SeekPlayback(uint32_t replayTick) = 0;
         virtual bool IsPlaybackStateMismatching() const = 0;
         virtual bool StopPlayback() = 0;
 
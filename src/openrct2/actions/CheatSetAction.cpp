@@ -36,6 +36,7 @@
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "../world/Surface.h"
+#include "../world/TileSummary.h"
 #include "ParkSetLoanAction.h"
 #include "ParkSetParameterAction.h"
 
@@ -471,6 +472,8 @@ void CheatSetAction::FixVandalism() const
         it.element->AsPath()->SetIsBroken(false);
     } while (TileElementIteratorNext(&it));
 
+    TileSummaryInvalidateAll();
+
     GfxInvalidateScreen();
 }
 
@@ -21,6 +21,7 @@
 #include "../world/Location.hpp"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
+#include "../world/TileSummary.h"
 #include "../world/Wall.h"
 
 FootpathAdditionPlaceAction::FootpathAdditionPlaceAction(const CoordsXYZ& loc, ObjectEntryIndex pathItemType)
@@ -183,6 +184,7 @@ GameActions::Result FootpathAdditionPlaceAction::Execute() const
 
     pathElement->SetAdditionEntryIndex(_entryIndex);
     pathElement->SetIsBroken(false);
+    TileSummaryInvalidateTile(_loc);
     if (pathAdditionEntry->flags & PATH_ADDITION_FLAG_IS_BIN)
     {
         pathElement->SetAdditionStatus(255);
@@ -18,6 +18,7 @@
 #include "../world/Footpath.h"
 #include "../world/Location.hpp"
 #include "../world/Park.h"
+#include "../world/TileSummary.h"
 #include "../world/Wall.h"
 
 FootpathAdditionRemoveAction::FootpathAdditionRemoveAction(const CoordsXYZ& loc)
@@ -105,6 +106,7 @@ GameActions::Result FootpathAdditionRemoveAction::Execute() const
 
     pathElement->SetAddition(0);
     MapInvalidateTileFull(_loc);
+    TileSummaryInvalidateTile(_loc);
 
     auto res = GameActions::Result();
     res.Position = _loc;
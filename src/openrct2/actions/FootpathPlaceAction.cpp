@@ -25,6 +25,7 @@
 #include "../world/Scenery.h"
 #include "../world/Surface.h"
 #include "../world/TileElementsView.h"
+#include "../world/TileSummary.h"
 #include "../world/Wall.h"
 
 using namespace OpenRCT2;
@@ -262,6 +263,7 @@ GameActions::Result FootpathPlaceAction::ElementUpdateExecute(PathElement* pathE
         }
     }
 
+    TileSummaryInvalidateTile(_loc);
     RemoveIntersectingWalls(pathElement);
     return res;
 }
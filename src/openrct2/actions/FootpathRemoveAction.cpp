@@ -97,7 +97,7 @@ GameActions::Result FootpathRemoveAction::Execute() const
         }
         FootpathRemoveEdgesAt(_loc, footpathElement);
         MapInvalidateTileFull(_loc);
-        TileElementRemove(footpathElement);
+        TileElementRemove(_loc, footpathElement);
         FootpathUpdateQueueChains();
 
         // Remove the spawn point (if there is one in the current tile)
@@ -262,7 +262,7 @@ void LandSetHeightAction::SmallSceneryRemoval() const
             continue;
         if (_height + 4 < tileElement->BaseHeight)
             continue;
-        TileElementRemove(tileElement--);
+        TileElementRemove(_coords, tileElement--);
     } while (!(tileElement++)->IsLastForTile());
 }
 
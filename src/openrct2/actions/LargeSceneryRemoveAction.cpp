@@ -187,7 +187,7 @@ GameActions::Result LargeSceneryRemoveAction::Execute() const
         if (sceneryElement != nullptr)
         {
             MapInvalidateTileFull(currentTile);
-            TileElementRemove(sceneryElement);
+            TileElementRemove(currentTile, sceneryElement);
         }
         else
         {
@@ -49,6 +49,11 @@ GameActions::Result MapChangeSizeAction::Query() const
 GameActions::Result MapChangeSizeAction::Execute() const
 {
     auto& gameState = OpenRCT2::GetGameState();
+
+    // Allocate the new tiles before extending the boundary surface into them
+    MapResizeTileElements(
+        { std::max(_targetSize.x, gameState.MapSize.x), std::max(_targetSize.y, gameState.MapSize.y) });
+
     // Expand map
     while (_targetSize.x > gameState.MapSize.x)
     {
@@ -66,6 +71,7 @@ GameActions::Result MapChangeSizeAction::Execute() const
     {
         gameState.MapSize = _targetSize;
         MapRemoveOutOfRangeElements();
+        MapResizeTileElements(gameState.MapSize);
     }
 
     auto* ctx = OpenRCT2::GetContext();
@@ -324,7 +324,7 @@ GameActions::Result MazeSetTrackAction::Execute() const
 
     if ((tileElement->AsTrack()->GetMazeEntry() & 0x8888) == 0x8888)
     {
-        TileElementRemove(tileElement);
+        TileElementRemove(_loc, tileElement);
         ride->ValidateStations();
         ride->maze_tiles--;
     }
@@ -104,6 +104,6 @@ void ParkEntranceRemoveAction::ParkEntranceRemoveSegment(const CoordsXYZ& loc) c
     }
 
     MapInvalidateTile({ loc, entranceElement->GetBaseZ(), entranceElement->GetClearanceZ() });
-    entranceElement->Remove();
+    entranceElement->Remove(loc);
     ParkUpdateFences({ loc.x, loc.y });
 }
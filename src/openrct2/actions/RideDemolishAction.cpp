@@ -231,7 +231,7 @@ money64 RideDemolishAction::DemolishTracks() const
                     auto removRes = GameActions::ExecuteNested(&trackRemoveAction);
                     if (removRes.Error != GameActions::Status::Ok)
                     {
-                        TileElementRemove(tileElement);
+                        TileElementRemove(tileCoords, tileElement);
                     }
                     else
                     {
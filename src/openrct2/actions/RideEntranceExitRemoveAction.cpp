@@ -153,7 +153,7 @@ GameActions::Result RideEntranceExitRemoveAction::Execute() const
     MazeEntranceHedgeReplacement({ _loc, entranceElement });
     FootpathRemoveEdgesAt(_loc, entranceElement);
 
-    TileElementRemove(entranceElement);
+    TileElementRemove(_loc, entranceElement);
 
     auto& station = ride->GetStation(_stationNum);
     if (_isExit)
@@ -133,7 +133,7 @@ GameActions::Result SmallSceneryRemoveAction::Execute() const
     res.Position.z = TileElementHeight(res.Position);
 
     MapInvalidateTileFull(_loc);
-    TileElementRemove(tileElement);
+    TileElementRemove(_loc, tileElement);
 
     return res;
 }
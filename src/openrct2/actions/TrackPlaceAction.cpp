@@ -19,6 +19,7 @@
 #include "../world/ConstructionClearance.h"
 #include "../world/MapAnimation.h"
 #include "../world/Surface.h"
+#include "../world/TileSummary.h"
 #include "RideSetSettingAction.h"
 
 using namespace OpenRCT2::TrackMetaData;
@@ -480,6 +481,7 @@ GameActions::Result TrackPlaceAction::Execute() const
             if (footpathElement != nullptr && footpathElement->HasAddition())
             {
                 footpathElement->SetAddition(0);
+                TileSummaryInvalidateTile(mapLoc);
             }
         }
 
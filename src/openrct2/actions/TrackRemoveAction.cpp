@@ -444,7 +444,7 @@ GameActions::Result TrackRemoveAction::Execute() const
         {
             FootpathRemoveEdgesAt(mapLoc, tileElement);
         }
-        TileElementRemove(tileElement);
+        TileElementRemove(mapLoc, tileElement);
         ride->ValidateStations();
         if (!(GetFlags() & GAME_COMMAND_FLAG_GHOST))
         {
@@ -87,7 +87,7 @@ GameActions::Result WallRemoveAction::Execute() const
 
     wallElement->RemoveBannerEntry();
     MapInvalidateTileZoom1({ _loc, wallElement->GetBaseZ(), (wallElement->GetBaseZ()) + 72 });
-    TileElementRemove(wallElement);
+    TileElementRemove(_loc, wallElement);
 
     return res;
 }
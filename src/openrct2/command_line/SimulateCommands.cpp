@@ -11,22 +11,55 @@
 #include "../Game.h"
 #include "../GameState.h"
 #include "../OpenRCT2.h"
+#include "../Version.h"
 #include "../core/Console.hpp"
+#include "../core/FileScanner.h"
+#include "../core/Json.hpp"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
 #include "../entity/EntityRegistry.h"
 #include "../network/network.h"
 #include "../platform/Platform.h"
+#include "../profiling/Profiling.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <memory>
+#include <numeric>
 
 using namespace OpenRCT2;
 
+struct SimulateBenchmarkOptions
+{
+    const char* Output = nullptr;
+    int32_t Warmup = 0;
+    bool NoBreakdown = false;
+};
+
+static SimulateBenchmarkOptions _benchmarkOptions;
+
+// clang-format off
+static constexpr CommandLineOptionDefinition BenchmarkOptionsDef[]
+{
+    { CMDLINE_TYPE_STRING,  &_benchmarkOptions.Output,      NAC, "output",       "write the results as JSON to the given file" },
+    { CMDLINE_TYPE_INTEGER, &_benchmarkOptions.Warmup,      NAC, "warmup",       "number of ticks to run before measuring" },
+    { CMDLINE_TYPE_SWITCH,  &_benchmarkOptions.NoBreakdown, NAC, "no-breakdown", "do not profile individual subsystems" },
+    OptionTableEnd
+};
+
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator);
+static exitcode_t HandleSimulateBenchmark(CommandLineArgEnumerator* argEnumerator);
 
-const CommandLineCommand CommandLine::SimulateCommands[]{ // Main commands
-                                                          DefineCommand("", "<ticks>", nullptr, HandleSimulate), CommandTableEnd
+const CommandLineCommand CommandLine::SimulateCommands[]
+{
+    // Main commands
+    DefineCommand("benchmark", "<file|directory> <ticks>", BenchmarkOptionsDef, HandleSimulateBenchmark),
+    DefineCommand("",          "<file> <ticks>",           nullptr,             HandleSimulate),
+    CommandTableEnd
 };
+// clang-format on
 
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 {
@@ -71,3 +104,257 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
 
     return EXITCODE_OK;
 }
+
+namespace
+{
+    struct BenchmarkSubsystem
+    {
+        const char* Name;
+        // Unique part of the profiled function signature, see PROFILED_FUNCTION.
+        const char* Signature;
+    };
+
+    // clang-format off
+    constexpr BenchmarkSubsystem BenchmarkSubsystems[] = {
+        { "PeepUpdateAll",        "PeepUpdateAll(" },
+        { "VehicleUpdateAll",     "VehicleUpdateAll(" },
+        { "RideRatingsUpdateAll", "RideRatingsUpdateAll(" },
+        { "MapUpdateTiles",       "MapUpdateTiles(" },
+        { "Park::Update",         "Park::Update(" },
+    };
+    // clang-format on
+
+    struct BenchmarkResult
+    {
+        u8string Path;
+        uint32_t Ticks{};
+        double TotalTimeMs{};
+        double TicksPerSecond{};
+        double MeanTickUs{};
+        double P50TickUs{};
+        double P99TickUs{};
+        double MaxTickUs{};
+        std::string Checksum;
+        std::vector<std::pair<const char*, double>> SubsystemTotalUs;
+    };
+} // namespace
+
+static std::vector<u8string> GetBenchmarkParkFiles(const u8string& path)
+{
+    std::vector<u8string> files;
+    if (Path::DirectoryExists(path))
+    {
+        auto pattern = Path::Combine(path, u8"*.park;*.sv6;*.sc6;*.sv4;*.sc4");
+        auto scanner = Path::ScanDirectory(pattern, true);
+        while (scanner->Next())
+        {
+            files.emplace_back(scanner->GetPath());
+        }
+        // Keep the order stable between runs so the output can be diffed.
+        std::sort(files.begin(), files.end());
+    }
+    else
+    {
+        files.push_back(path);
+    }
+    return files;
+}
+
+static double GetPercentile(const std::vector<double>& sortedSamples, double percentile)
+{
+    if (sortedSamples.empty())
+        return 0.0;
+
+    auto index = static_cast<size_t>(percentile * static_cast<double>(sortedSamples.size()));
+    return sortedSamples[std::min(index, sortedSamples.size() - 1)];
+}
+
+static double GetProfiledTotalTime(const char* signature)
+{
+    for (const auto* func : Profiling::GetData())
+    {
+        if (String::Contains(func->GetName(), signature))
+        {
+            return func->GetTotalTime();
+        }
+    }
+    return 0.0;
+}
+
+static bool RunParkBenchmark(IContext& context, const u8string& path, uint32_t ticks, BenchmarkResult& result)
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    if (!context.LoadParkFromFile(path))
+    {
+        return false;
+    }
+
+    auto* gameState = context.GetGameState();
+    for (int32_t i = 0; i < _benchmarkOptions.Warmup; i++)
+    {
+        gameState->UpdateLogic();
+    }
+
+    std::vector<double> samples;
+    samples.reserve(ticks);
+
+    Profiling::ResetData();
+    if (!_benchmarkOptions.NoBreakdown)
+    {
+        Profiling::Enable();
+    }
+
+    for (uint32_t i = 0; i < ticks; i++)
+    {
+        const auto tickStart = Clock::now();
+        gameState->UpdateLogic();
+        const auto tickEnd = Clock::now();
+        samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(tickEnd - tickStart).count() / 1000.0);
+    }
+
+    Profiling::Disable();
+
+    result.Path = path;
+    result.Ticks = ticks;
+    result.Checksum = GetAllEntitiesChecksum().ToString();
+
+    const auto totalUs = std::accumulate(samples.begin(), samples.end(), 0.0);
+    result.TotalTimeMs = totalUs / 1000.0;
+    if (ticks > 0)
+    {
+        result.MeanTickUs = totalUs / ticks;
+    }
+    if (totalUs > 0.0)
+    {
+        result.TicksPerSecond = ticks / (totalUs / 1000000.0);
+    }
+
+    std::sort(samples.begin(), samples.end());
+    result.P50TickUs = GetPercentile(samples, 0.50);
+    result.P99TickUs = GetPercentile(samples, 0.99);
+    result.MaxTickUs = samples.empty() ? 0.0 : samples.back();
+
+    if (!_benchmarkOptions.NoBreakdown)
+    {
+        for (const auto& subsystem : BenchmarkSubsystems)
+        {
+            result.SubsystemTotalUs.emplace_back(subsystem.Name, GetProfiledTotalTime(subsystem.Signature));
+        }
+    }
+    return true;
+}
+
+static void PrintBenchmarkResult(const BenchmarkResult& result)
+{
+    Console::WriteLine("%s", result.Path.c_str());
+    Console::WriteLine(
+        "  %u ticks in %.2f ms, %.1f ticks/s", result.Ticks, result.TotalTimeMs, result.TicksPerSecond);
+    Console::WriteLine(
+        "  tick latency: mean %.1f us, p50 %.1f us, p99 %.1f us, max %.1f us", result.MeanTickUs, result.P50TickUs,
+        result.P99TickUs, result.MaxTickUs);
+    for (const auto& [name, totalUs] : result.SubsystemTotalUs)
+    {
+        const auto share = result.TotalTimeMs > 0.0 ? totalUs / (result.TotalTimeMs * 10.0) : 0.0;
+        Console::WriteLine(
+            "  %-22s %10.1f us/tick %6.1f%%", name, result.Ticks > 0 ? totalUs / result.Ticks : 0.0, share);
+    }
+    Console::WriteLine("  checksum: %s", result.Checksum.c_str());
+}
+
+static json_t BenchmarkResultToJson(const BenchmarkResult& result)
+{
+    json_t subsystems = json_t::object();
+    for (const auto& [name, totalUs] : result.SubsystemTotalUs)
+    {
+        subsystems[name] = {
+            { "totalUs", totalUs },
+            { "meanTickUs", result.Ticks > 0 ? totalUs / result.Ticks : 0.0 },
+        };
+    }
+
+    return {
+        { "path", result.Path },
+        { "ticks", result.Ticks },
+        { "totalMs", result.TotalTimeMs },
+        { "ticksPerSecond", result.TicksPerSecond },
+        { "meanTickUs", result.MeanTickUs },
+        { "p50TickUs", result.P50TickUs },
+        { "p99TickUs", result.P99TickUs },
+        { "maxTickUs", result.MaxTickUs },
+        { "checksum", result.Checksum },
+        { "subsystems", subsystems },
+    };
+}
+
+static exitcode_t HandleSimulateBenchmark(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* rawInputPath;
+    if (!argEnumerator->TryPopString(&rawInputPath))
+    {
+        Console::Error::WriteLine("Expected a park file or a directory of park files.");
+        return EXITCODE_FAIL;
+    }
+
+    int32_t ticks;
+    if (!argEnumerator->TryPopInteger(&ticks) || ticks <= 0)
+    {
+        Console::Error::WriteLine("Expected a positive number of ticks.");
+        return EXITCODE_FAIL;
+    }
+
+    auto files = GetBenchmarkParkFiles(Path::GetAbsolute(rawInputPath));
+    if (files.empty())
+    {
+        Console::Error::WriteLine("No park files found in %s.", rawInputPath);
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+
+#ifndef DISABLE_NETWORK
+    gNetworkStart = NETWORK_MODE_SERVER;
+#endif
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    json_t jsonResults = json_t::array();
+    bool anyFailed = false;
+    for (const auto& file : files)
+    {
+        BenchmarkResult result;
+        if (!RunParkBenchmark(*context, file, static_cast<uint32_t>(ticks), result))
+        {
+            Console::Error::WriteLine("Unable to load %s.", file.c_str());
+            anyFailed = true;
+            continue;
+        }
+        PrintBenchmarkResult(result);
+        jsonResults.push_back(BenchmarkResultToJson(result));
+    }
+
+    if (_benchmarkOptions.Output != nullptr)
+    {
+        json_t jsonRoot = {
+            { "version", std::string(gVersionInfoFull) },
+            { "warmupTicks", _benchmarkOptions.Warmup },
+            { "parks", jsonResults },
+        };
+        try
+        {
+            Json::WriteToFile(_benchmarkOptions.Output, jsonRoot);
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to write %s: %s", _benchmarkOptions.Output, e.what());
+            return EXITCODE_FAIL;
+        }
+    }
+
+    return anyFailed ? EXITCODE_FAIL : EXITCODE_OK;
+}
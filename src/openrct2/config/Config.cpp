@@ -539,6 +539,7 @@ namespace Config
             model->HeightBig = reader->GetInt32("height_big", false);
             model->EnableHinting = reader->GetBoolean("enable_hinting", true);
             model->HintingThreshold = reader->GetInt32("hinting_threshold", false);
+            model->CacheSize = reader->GetInt32("cache_size", 8192);
         }
     }
 
@@ -560,6 +561,7 @@ namespace Config
         writer->WriteInt32("height_big", model->HeightBig);
         writer->WriteBoolean("enable_hinting", model->EnableHinting);
         writer->WriteInt32("hinting_threshold", model->HintingThreshold);
+        writer->WriteInt32("cache_size", model->CacheSize);
     }
 
     static void ReadPlugin(IIniReader* reader)
@@ -569,6 +571,7 @@ namespace Config
             auto model = &gConfigPlugin;
             model->EnableHotReloading = reader->GetBoolean("enable_hot_reloading", false);
             model->AllowedHosts = reader->GetString("allowed_hosts", "");
+            model->TickBudget = reader->GetFloat("tick_budget", 0.0f);
         }
     }
 
@@ -578,6 +581,7 @@ namespace Config
         writer->WriteSection("plugin");
         writer->WriteBoolean("enable_hot_reloading", model->EnableHotReloading);
         writer->WriteString("allowed_hosts", model->AllowedHosts);
+        writer->WriteFloat("tick_budget", model->TickBudget);
     }
 
     static bool SetDefaults()
@@ -213,12 +213,14 @@ struct FontConfiguration
     int32_t HeightBig;
     bool EnableHinting;
     int32_t HintingThreshold;
+    int32_t CacheSize;
 };
 
 struct PluginConfiguration
 {
     bool EnableHotReloading;
     u8string AllowedHosts;
+    float TickBudget;
 };
 
 enum class Sort : int32_t
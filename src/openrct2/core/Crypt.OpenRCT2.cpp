@@ -55,12 +55,14 @@ public:
         if (_remLen > 0)
         {
             // We have remainder, so fill rest of it with bytes from src
-            auto fillLen = sizeof(uint64_t) - _remLen;
+            auto fillLen = std::min(sizeof(uint64_t) - _remLen, dataLen);
             assert(_remLen + fillLen <= sizeof(uint64_t));
             std::memcpy(_rem + _remLen, src, fillLen);
             src = reinterpret_cast<const uint64_t*>(reinterpret_cast<const uint8_t*>(src) + fillLen);
             _remLen += fillLen;
             dataLen -= fillLen;
+            if (_remLen < sizeof(uint64_t))
+                return this;
             ProcessRemainder();
         }
 
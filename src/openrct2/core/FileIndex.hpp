@@ -16,38 +16,34 @@
 #include "FileScanner.h"
 #include "FileStream.h"
 #include "JobPool.h"
-#include "Numerics.hpp"
 #include "Path.hpp"
 
+#include <algorithm>
 #include <chrono>
-#include <list>
+#include <optional>
 #include <string>
-#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 template<typename TItem> class FileIndex
 {
 private:
-    struct DirectoryStats
+    struct ScannedFile
     {
-        uint32_t TotalFiles = 0;
-        uint64_t TotalFileSize = 0;
-        uint32_t FileDateModifiedChecksum = 0;
-        uint32_t PathChecksum = 0;
+        std::string Path;
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
     };
 
-    struct ScanResult
+    struct IndexEntry
     {
-        DirectoryStats const Stats;
-        std::vector<std::string> const Files;
-
-        ScanResult(DirectoryStats stats, std::vector<std::string>&& files) noexcept
-            : Stats(stats)
-            , Files(std::move(files))
-        {
-        }
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+        std::optional<TItem> Item;
     };
 
+    using IndexEntries = std::unordered_map<std::string, IndexEntry>;
+
     struct FileIndexHeader
     {
         uint32_t HeaderSize = sizeof(FileIndexHeader);
@@ -55,12 +51,11 @@ private:
         uint8_t VersionA = 0;
         uint8_t VersionB = 0;
         uint16_t LanguageId = 0;
-        DirectoryStats Stats;
-        uint32_t NumItems = 0;
+        uint32_t NumEntries = 0;
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8_t FILE_INDEX_VERSION = 4;
+    static constexpr uint8_t FILE_INDEX_VERSION = 5;
 
     std::string const _name;
     uint32_t const _magicNumber;
@@ -96,32 +91,20 @@ public:
     virtual ~FileIndex() = default;
 
     /**
-     * Queries and directories and loads the index header. If the index is up to date,
-     * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Queries the directories and loads the index. Items of files whose size and modification date are unchanged
+     * are taken from the index, only new or modified files are loaded again. Entries of deleted files are dropped.
      */
     std::vector<TItem> LoadOrBuild(int32_t language) const
     {
-        std::vector<TItem> items;
-        auto scanResult = Scan();
-        auto readIndexResult = ReadIndexFile(language, scanResult.Stats);
-        if (std::get<0>(readIndexResult))
-        {
-            // Index was loaded
-            items = std::get<1>(readIndexResult);
-        }
-        else
-        {
-            // Index was not loaded
-            items = Build(language, scanResult);
-        }
-        return items;
+        auto files = Scan();
+        auto entries = ReadIndexFile(language);
+        return Build(language, files, std::move(entries));
     }
 
     std::vector<TItem> Rebuild(int32_t language) const
     {
-        auto scanResult = Scan();
-        auto items = Build(language, scanResult);
-        return items;
+        auto files = Scan();
+        return Build(language, files, {});
     }
 
 protected:
@@ -136,10 +119,9 @@ protected:
     virtual void Serialise(DataSerialiser& ds, const TItem& item) const abstract;
 
 private:
-    ScanResult Scan() const
+    std::vector<ScannedFile> Scan() const
     {
-        DirectoryStats stats{};
-        std::vector<std::string> files;
+        std::vector<ScannedFile> files;
         for (const auto& directory : SearchPaths)
         {
             auto absoluteDirectory = Path::GetAbsolute(directory);
@@ -150,29 +132,21 @@ private:
             while (scanner->Next())
             {
                 const auto& fileInfo = scanner->GetFileInfo();
-                auto path = scanner->GetPath();
-
-                stats.TotalFiles++;
-                stats.TotalFileSize += fileInfo.Size;
-                stats.FileDateModifiedChecksum ^= static_cast<uint32_t>(fileInfo.LastModified >> 32)
-                    ^ static_cast<uint32_t>(fileInfo.LastModified & 0xFFFFFFFF);
-                stats.FileDateModifiedChecksum = Numerics::ror32(stats.FileDateModifiedChecksum, 5);
-                stats.PathChecksum += GetPathChecksum(path);
-
-                files.push_back(std::move(path));
+                files.push_back({ scanner->GetPath(), fileInfo.Size, fileInfo.LastModified });
             }
         }
-        return ScanResult(stats, std::move(files));
+        return files;
     }
 
     void BuildRange(
-        int32_t language, const ScanResult& scanResult, size_t rangeStart, size_t rangeEnd, std::vector<TItem>& items,
-        std::atomic<size_t>& processed, std::mutex& printLock) const
+        int32_t language, const std::vector<ScannedFile>& files, const std::vector<size_t>& outdated, size_t rangeStart,
+        size_t rangeEnd, std::vector<std::optional<TItem>>& items, std::atomic<size_t>& processed,
+        std::mutex& printLock) const
     {
-        items.reserve(rangeEnd - rangeStart);
         for (size_t i = rangeStart; i < rangeEnd; i++)
         {
-            const auto& filePath = scanResult.Files.at(i);
+            const auto fileIndex = outdated[i];
+            const auto& filePath = files[fileIndex].Path;
 
             if (_log_levels[static_cast<uint8_t>(DiagnosticLevel::Verbose)])
             {
@@ -180,76 +154,94 @@ private:
                 LOG_VERBOSE("FileIndex:Indexing '%s'", filePath.c_str());
             }
 
-            if (auto item = Create(language, filePath); item.has_value())
-            {
-                items.push_back(std::move(item.value()));
-            }
+            items[fileIndex] = Create(language, filePath);
 
             ++processed;
         }
     }
 
-    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult) const
+    std::vector<TItem> Build(int32_t language, const std::vector<ScannedFile>& files, IndexEntries&& entries) const
     {
-        std::vector<TItem> allItems;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
-
-        auto startTime = std::chrono::high_resolution_clock::now();
-
-        const size_t totalCount = scanResult.Files.size();
-        if (totalCount > 0)
+        // Reuse the indexed item of every file that is unchanged, whatever remains in entries has been deleted.
+        std::vector<std::optional<TItem>> items(files.size());
+        std::vector<size_t> outdated;
+        for (size_t i = 0; i < files.size(); i++)
         {
-            JobPool jobPool;
-            std::mutex printLock; // For verbose prints.
-
-            std::list<std::vector<TItem>> containers;
-
-            size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
-
-            std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
-
-            auto reportProgress = [&]() {
-                const size_t completed = processed;
-                Console::WriteFormat("File %5zu of %zu, done %3d%%\r", completed, totalCount, completed * 100 / totalCount);
-            };
-
-            for (size_t rangeStart = 0; rangeStart < totalCount; rangeStart += stepSize)
+            const auto& file = files[i];
+            auto it = entries.find(file.Path);
+            if (it != entries.end() && it->second.Size == file.Size && it->second.LastModified == file.LastModified)
             {
-                if (rangeStart + stepSize > totalCount)
-                {
-                    stepSize = totalCount - rangeStart;
-                }
-
-                auto& items = containers.emplace_back();
+                items[i] = std::move(it->second.Item);
+                entries.erase(it);
+            }
+            else
+            {
+                outdated.push_back(i);
+            }
+        }
 
-                jobPool.AddTask([&, rangeStart, stepSize]() {
-                    BuildRange(language, scanResult, rangeStart, rangeStart + stepSize, items, processed, printLock);
-                });
+        if (!outdated.empty() || !entries.empty())
+        {
+            auto startTime = std::chrono::high_resolution_clock::now();
 
-                reportProgress();
+            const size_t totalCount = outdated.size();
+            if (totalCount == files.size())
+            {
+                Console::WriteLine("Building %s (%zu items)", _name.c_str(), totalCount);
+            }
+            else
+            {
+                Console::WriteLine(
+                    "Updating %s (%zu of %zu items, %zu removed)", _name.c_str(), totalCount, files.size(), entries.size());
             }
 
-            jobPool.Join(reportProgress);
-
-            for (const auto& itr : containers)
+            if (totalCount > 0)
             {
-                allItems.insert(allItems.end(), itr.begin(), itr.end());
+                JobPool jobPool;
+                std::mutex printLock; // For verbose prints.
+
+                constexpr size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
+                const size_t numRanges = (totalCount + stepSize - 1) / stepSize;
+
+                std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
+
+                auto reportProgress = [&]() {
+                    const size_t completed = processed;
+                    Console::WriteFormat("File %5zu of %zu, done %3d%%\r", completed, totalCount, completed * 100 / totalCount);
+                };
+
+                jobPool.ParallelFor(
+                    numRanges,
+                    [&](size_t rangeIndex) {
+                        const size_t rangeStart = rangeIndex * stepSize;
+                        const size_t rangeEnd = std::min(rangeStart + stepSize, totalCount);
+                        BuildRange(language, files, outdated, rangeStart, rangeEnd, items, processed, printLock);
+                    },
+                    1, reportProgress);
             }
-        }
 
-        WriteIndexFile(language, scanResult.Stats, allItems);
+            WriteIndexFile(language, files, items);
 
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration<float>(endTime - startTime);
-        Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
+            auto endTime = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration<float>(endTime - startTime);
+            Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
+        }
 
+        std::vector<TItem> allItems;
+        allItems.reserve(items.size());
+        for (auto& item : items)
+        {
+            if (item.has_value())
+            {
+                allItems.push_back(std::move(item.value()));
+            }
+        }
         return allItems;
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    IndexEntries ReadIndexFile(int32_t language) const
     {
-        bool loadedItems = false;
-        std::vector<TItem> items;
+        IndexEntries entries;
         if (File::Exists(_indexPath))
         {
             try
@@ -257,24 +249,30 @@ private:
                 LOG_VERBOSE("FileIndex:Loading index: '%s'", _indexPath.c_str());
                 auto fs = OpenRCT2::FileStream(_indexPath, OpenRCT2::FILE_MODE_OPEN);
 
-                // Read header, check if we need to re-scan
+                // Read header, entries of an index in a different format or language can not be reused
                 auto header = fs.ReadValue<FileIndexHeader>();
                 if (header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
-                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language
-                    && header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
-                    && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
-                    && header.Stats.PathChecksum == stats.PathChecksum)
+                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language)
                 {
-                    items.reserve(header.NumItems);
+                    entries.reserve(header.NumEntries);
                     DataSerialiser ds(false, fs);
-                    // Directory is the same, just read the saved items
-                    for (uint32_t i = 0; i < header.NumItems; i++)
+                    for (uint32_t i = 0; i < header.NumEntries; i++)
                     {
-                        TItem item;
-                        Serialise(ds, item);
-                        items.emplace_back(std::move(item));
+                        std::string path;
+                        IndexEntry entry;
+                        bool hasItem = false;
+                        ds << path;
+                        ds << entry.Size;
+                        ds << entry.LastModified;
+                        ds << hasItem;
+                        if (hasItem)
+                        {
+                            TItem item;
+                            Serialise(ds, item);
+                            entry.Item = std::move(item);
+                        }
+                        entries.insert_or_assign(std::move(path), std::move(entry));
                     }
-                    loadedItems = true;
                 }
                 else
                 {
@@ -285,12 +283,14 @@ private:
             {
                 Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
                 Console::Error::WriteLine("%s", e.what());
+                entries.clear();
             }
         }
-        return std::make_tuple(loadedItems, std::move(items));
+        return entries;
     }
 
-    void WriteIndexFile(int32_t language, const DirectoryStats& stats, const std::vector<TItem>& items) const
+    void WriteIndexFile(
+        int32_t language, const std::vector<ScannedFile>& files, const std::vector<std::optional<TItem>>& items) const
     {
         try
         {
@@ -304,15 +304,23 @@ private:
             header.VersionA = FILE_INDEX_VERSION;
             header.VersionB = _version;
             header.LanguageId = language;
-            header.Stats = stats;
-            header.NumItems = static_cast<uint32_t>(items.size());
+            header.NumEntries = static_cast<uint32_t>(files.size());
             fs.WriteValue(header);
 
             DataSerialiser ds(true, fs);
-            // Write items
-            for (const auto& item : items)
+            // Write an entry for every file, including files that did not produce an item so they are not loaded again
+            for (size_t i = 0; i < files.size(); i++)
             {
-                Serialise(ds, item);
+                const auto& file = files[i];
+                bool hasItem = items[i].has_value();
+                ds << file.Path;
+                ds << file.Size;
+                ds << file.LastModified;
+                ds << hasItem;
+                if (hasItem)
+                {
+                    Serialise(ds, items[i].value());
+                }
             }
         }
         catch (const std::exception& e)
@@ -321,19 +329,4 @@ private:
             Console::Error::WriteLine("%s", e.what());
         }
     }
-
-    static uint32_t GetPathChecksum(const std::string& path)
-    {
-        uint32_t hash = 0xD8430DED;
-        for (const utf8* ch = path.c_str(); *ch != '\0'; ch++)
-        {
-            hash += (*ch);
-            hash += (hash << 10);
-            hash ^= (hash >> 6);
-        }
-        hash += (hash << 3);
-        hash ^= (hash >> 11);
-        hash += (hash << 15);
-        return hash;
-    }
 };
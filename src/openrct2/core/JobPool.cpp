@@ -10,20 +10,123 @@
 #include "JobPool.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 
-JobPool::TaskData::TaskData(std::function<void()> workFn, std::function<void()> completionFn)
-    : WorkFn(workFn)
-    , CompletionFn(completionFn)
+// Amount of failed attempts to find work before a worker goes to sleep.
+static constexpr size_t kIdleSpinCount = 64;
+
+// Minimum time between calls to the report function while waiting.
+static constexpr auto kReportInterval = std::chrono::milliseconds(100);
+
+// The deque of the thread outside the pool that submits work.
+static constexpr size_t kSubmitterDequeIndex = 0;
+
+static thread_local const JobPool* _currentPool = nullptr;
+static thread_local size_t _currentDequeIndex = 0;
+
+/**
+ * Fixed capacity Chase-Lev deque. The owning thread pushes and pops at the bottom, other threads steal from the top.
+ * Slots are atomic so a thief reading a slot that is concurrently reused only ever sees a value it will discard.
+ */
+class JobPool::TaskDeque
 {
-}
+private:
+    static constexpr int64_t kCapacity = 256;
+    static constexpr int64_t kMask = kCapacity - 1;
+    static_assert((kCapacity & kMask) == 0, "Capacity must be a power of two");
+
+    struct Slot
+    {
+        std::atomic<Job*> Owner;
+        std::atomic<size_t> Begin;
+        std::atomic<size_t> End;
+    };
+
+    std::atomic<int64_t> _top = { 0 };
+    std::atomic<int64_t> _bottom = { 0 };
+    std::array<Slot, kCapacity> _slots;
+
+    void Store(int64_t index, const Task& task)
+    {
+        auto& slot = _slots[index & kMask];
+        slot.Owner.store(task.Owner, std::memory_order_relaxed);
+        slot.Begin.store(task.Begin, std::memory_order_relaxed);
+        slot.End.store(task.End, std::memory_order_relaxed);
+    }
+
+    Task Load(int64_t index) const
+    {
+        const auto& slot = _slots[index & kMask];
+        return { slot.Owner.load(std::memory_order_relaxed), slot.Begin.load(std::memory_order_relaxed),
+                 slot.End.load(std::memory_order_relaxed) };
+    }
+
+public:
+    bool Push(const Task& task)
+    {
+        const auto bottom = _bottom.load(std::memory_order_relaxed);
+        const auto top = _top.load(std::memory_order_acquire);
+        if (bottom - top >= kCapacity)
+            return false;
+
+        Store(bottom, task);
+        _bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(Task& task)
+    {
+        const auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = _top.load(std::memory_order_relaxed);
+        if (top > bottom)
+        {
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        task = Load(bottom);
+        if (top == bottom)
+        {
+            // Last task, race against thieves for it.
+            const bool won = _top.compare_exchange_strong(
+                top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    bool Steal(Task& task)
+    {
+        auto top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto bottom = _bottom.load(std::memory_order_acquire);
+        if (top >= bottom)
+            return false;
+
+        task = Load(top);
+        return _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+};
 
 JobPool::JobPool(size_t maxThreads)
 {
+    // The submitting thread does work as well, so one thread less is needed.
     maxThreads = std::min<size_t>(maxThreads, std::thread::hardware_concurrency());
-    for (size_t n = 0; n < maxThreads; n++)
+    const size_t numWorkers = maxThreads > 1 ? maxThreads - 1 : 0;
+
+    for (size_t n = 0; n < numWorkers + 1; n++)
+    {
+        _deques.push_back(std::make_unique<TaskDeque>());
+    }
+    for (size_t n = 0; n < numWorkers; n++)
     {
-        _threads.emplace_back(&JobPool::ProcessQueue, this);
+        _threads.emplace_back(&JobPool::ProcessQueue, this, n + 1);
     }
 }
 
@@ -42,85 +145,152 @@ JobPool::~JobPool()
     }
 }
 
-void JobPool::AddTask(std::function<void()> workFn, std::function<void()> completionFn)
+void JobPool::Run(TaskFn fn, void* context, size_t count, size_t grainSize, const std::function<void()>& reportFn)
 {
-    unique_lock lock(_mutex);
-    _pending.emplace_back(workFn, completionFn);
-    _condPending.notify_one();
-}
+    if (count == 0)
+        return;
 
-void JobPool::Join(std::function<void()> reportFn)
-{
-    unique_lock lock(_mutex);
-    while (true)
+    if (_threads.empty())
     {
-        // Wait for the queue to become empty or having completed tasks.
-        _condComplete.wait(lock, [this]() { return (_pending.empty() && _processing == 0) || !_completed.empty(); });
-
-        // Dispatch all completion callbacks if there are any.
-        while (!_completed.empty())
-        {
-            auto taskData = _completed.front();
-            _completed.pop_front();
-
-            if (taskData.CompletionFn)
-            {
-                lock.unlock();
+        fn(context, 0, count);
+        if (reportFn)
+            reportFn();
+        return;
+    }
 
-                taskData.CompletionFn();
+    Job job{ fn, context, std::max<size_t>(grainSize, 1), { 1 } };
+    const auto dequeIndex = GetCurrentDequeIndex();
+    Execute(dequeIndex, { &job, 0, count });
 
-                lock.lock();
-            }
+    // Help out until every part of the job is done, stolen parts may still be running on other threads.
+    auto lastReport = std::chrono::steady_clock::now();
+    while (job.Pending.load(std::memory_order_acquire) != 0)
+    {
+        Task task;
+        if (TryGetTask(dequeIndex, task))
+        {
+            Execute(dequeIndex, task);
         }
-
-        if (reportFn)
+        else
         {
-            lock.unlock();
-
-            reportFn();
-
-            lock.lock();
+            std::this_thread::yield();
         }
 
-        // If everything is empty and no more work has to be done we can stop waiting.
-        if (_completed.empty() && _pending.empty() && _processing == 0)
+        if (reportFn)
         {
-            break;
+            const auto now = std::chrono::steady_clock::now();
+            if (now - lastReport >= kReportInterval)
+            {
+                reportFn();
+                lastReport = now;
+            }
         }
     }
+
+    if (reportFn)
+        reportFn();
 }
 
-size_t JobPool::CountPending()
+size_t JobPool::GetCurrentDequeIndex() const
 {
-    unique_lock lock(_mutex);
-    return _pending.size();
+    if (_currentPool == this)
+        return _currentDequeIndex;
+    return kSubmitterDequeIndex;
 }
 
-void JobPool::ProcessQueue()
+bool JobPool::Push(size_t dequeIndex, const Task& task)
 {
-    unique_lock lock(_mutex);
-    do
+    // Counted before the push so a thief can never decrement it below zero.
+    _queued.fetch_add(1, std::memory_order_seq_cst);
+    if (!_deques[dequeIndex]->Push(task))
     {
-        // Wait for work or cancellation.
-        _condPending.wait(lock, [this]() { return _shouldStop || !_pending.empty(); });
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (_sleeping.load(std::memory_order_seq_cst) != 0)
+    {
+        // Taking the lock ensures a worker that is about to sleep either sees the task or receives the notification.
+        unique_lock lock(_mutex);
+        _condPending.notify_one();
+    }
+    return true;
+}
+
+bool JobPool::TryGetTask(size_t dequeIndex, Task& task)
+{
+    if (_deques[dequeIndex]->Pop(task))
+    {
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
 
-        if (!_pending.empty())
+    const auto numDeques = _deques.size();
+    for (size_t n = 1; n < numDeques; n++)
+    {
+        const auto victim = (dequeIndex + n) % numDeques;
+        if (_deques[victim]->Steal(task))
         {
-            _processing++;
+            _queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobPool::Execute(size_t dequeIndex, Task task)
+{
+    auto* job = task.Owner;
 
-            auto taskData = _pending.front();
-            _pending.pop_front();
+    // Split off the upper half for other threads to steal until the remaining range is small enough.
+    while (task.End - task.Begin > job->GrainSize)
+    {
+        const auto middle = task.Begin + (task.End - task.Begin) / 2;
+        job->Pending.fetch_add(1, std::memory_order_relaxed);
+        if (!Push(dequeIndex, { job, middle, task.End }))
+        {
+            // Deque is full, run the whole range here.
+            job->Pending.fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+        task.End = middle;
+    }
 
-            lock.unlock();
+    job->Fn(job->Context, task.Begin, task.End);
 
-            taskData.WorkFn();
+    // The job may be destroyed as soon as the last part completes, it must not be accessed after this.
+    job->Pending.fetch_sub(1, std::memory_order_acq_rel);
+}
 
-            lock.lock();
+void JobPool::ProcessQueue(size_t dequeIndex)
+{
+    _currentPool = this;
+    _currentDequeIndex = dequeIndex;
 
-            _completed.push_back(std::move(taskData));
+    size_t idleSpins = 0;
+    while (!_shouldStop)
+    {
+        Task task;
+        if (TryGetTask(dequeIndex, task))
+        {
+            Execute(dequeIndex, task);
+            idleSpins = 0;
+            continue;
+        }
 
-            _processing--;
-            _condComplete.notify_one();
+        if (++idleSpins < kIdleSpinCount)
+        {
+            std::this_thread::yield();
+            continue;
         }
-    } while (!_shouldStop);
+
+        // Wait for work or cancellation.
+        idleSpins = 0;
+        unique_lock lock(_mutex);
+        _sleeping++;
+        _condPending.wait(lock, [this]() { return _shouldStop || _queued.load(std::memory_order_seq_cst) != 0; });
+        _sleeping--;
+    }
+
+    _currentPool = nullptr;
 }
@@ -11,30 +11,47 @@
 
 #include <atomic>
 #include <condition_variable>
-#include <deque>
+#include <cstddef>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
+/**
+ * Work-stealing thread pool. Every thread owns a lock-free task deque and idle threads steal work from the deques of
+ * the others. The thread calling ParallelFor takes part in running the work until all of it is done.
+ * Work may only be submitted by one thread outside of the pool at a time, tasks themselves may submit nested work.
+ */
 class JobPool
 {
 private:
-    struct TaskData
+    using TaskFn = void (*)(void* context, size_t begin, size_t end);
+
+    struct Job
     {
-        const std::function<void()> WorkFn;
-        const std::function<void()> CompletionFn;
+        TaskFn Fn;
+        void* Context;
+        size_t GrainSize;
+        std::atomic<size_t> Pending;
+    };
 
-        TaskData(std::function<void()> workFn, std::function<void()> completionFn);
+    struct Task
+    {
+        Job* Owner;
+        size_t Begin;
+        size_t End;
     };
 
+    class TaskDeque;
+
     std::atomic_bool _shouldStop = { false };
-    std::atomic<size_t> _processing = { 0 };
+    std::atomic<size_t> _queued = { 0 };
+    std::atomic<size_t> _sleeping = { 0 };
+    std::vector<std::unique_ptr<TaskDeque>> _deques;
     std::vector<std::thread> _threads;
-    std::deque<TaskData> _pending;
-    std::deque<TaskData> _completed;
     std::condition_variable _condPending;
-    std::condition_variable _condComplete;
     std::mutex _mutex;
 
     using unique_lock = std::unique_lock<std::mutex>;
@@ -43,10 +60,30 @@ public:
     JobPool(size_t maxThreads = 255);
     ~JobPool();
 
-    void AddTask(std::function<void()> workFn, std::function<void()> completionFn = nullptr);
-    void Join(std::function<void()> reportFn = nullptr);
-    size_t CountPending();
+    /**
+     * Calls fn(i) for every i in [0, count) across the pool and returns once all calls have completed. The range is
+     * split in halves down to grainSize, each thread keeps working on its own half while other threads steal the rest.
+     * reportFn is called periodically from the calling thread while waiting.
+     */
+    template<typename TFn>
+    void ParallelFor(size_t count, TFn&& fn, size_t grainSize = 1, const std::function<void()>& reportFn = nullptr)
+    {
+        using TCallback = std::remove_reference_t<TFn>;
+        auto invoke = [](void* context, size_t begin, size_t end) {
+            auto& callback = *static_cast<TCallback*>(context);
+            for (size_t i = begin; i < end; i++)
+            {
+                callback(i);
+            }
+        };
+        Run(invoke, const_cast<void*>(static_cast<const void*>(&fn)), count, grainSize, reportFn);
+    }
 
 private:
-    void ProcessQueue();
+    void Run(TaskFn fn, void* context, size_t count, size_t grainSize, const std::function<void()>& reportFn);
+    size_t GetCurrentDequeIndex() const;
+    bool Push(size_t dequeIndex, const Task& task);
+    bool TryGetTask(size_t dequeIndex, Task& task);
+    void Execute(size_t dequeIndex, Task task);
+    void ProcessQueue(size_t dequeIndex);
 };
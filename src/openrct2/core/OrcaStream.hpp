@@ -9,16 +9,23 @@
 
 #pragma once
 
+#include "../util/Util.h"
 #include "../world/Location.hpp"
 #include "Crypt.h"
 #include "FileStream.h"
 #include "Identifier.hpp"
+#include "JobPool.h"
 #include "MemoryStream.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <exception>
 #include <fstream>
+#include <memory>
+#include <optional>
 #include <sstream>
 #include <stack>
 #include <type_traits>
@@ -37,8 +44,15 @@ namespace OpenRCT2
 
         static constexpr uint32_t COMPRESSION_NONE = 0;
         static constexpr uint32_t COMPRESSION_GZIP = 1;
+        // Each chunk is split into blocks which are compressed independently, so that a single chunk can be read
+        // without decompressing the rest of the file and blocks can be (de)compressed in parallel.
+        static constexpr uint32_t COMPRESSION_GZIP_CHUNKED = 2;
 
     private:
+        // Uncompressed size of the blocks written in COMPRESSION_GZIP_CHUNKED mode, the last block of a chunk may be
+        // smaller. Readers take the size of each block from the block table.
+        static constexpr size_t kBlockSize = 256 * 1024;
+
 #pragma pack(push, 1)
         struct Header
         {
@@ -60,8 +74,25 @@ namespace OpenRCT2
             uint64_t Offset{};
             uint64_t Length{};
         };
+
+        // Follows the chunk table in COMPRESSION_GZIP_CHUNKED mode, the blocks of each chunk are listed in chunk order.
+        struct BlockEntry
+        {
+            uint64_t Offset{};
+            uint32_t CompressedLength{};
+            uint32_t UncompressedLength{};
+        };
 #pragma pack(pop)
 
+        struct ChunkBlocks
+        {
+            size_t First{};
+            size_t Count{};
+            bool Loaded{};
+            // Uncompressed chunk, only allocated once the chunk is first read
+            std::vector<uint8_t> Data;
+        };
+
         IStream* _stream;
         Mode _mode;
         Header _header;
@@ -69,6 +100,20 @@ namespace OpenRCT2
         MemoryStream _buffer;
         ChunkEntry _currentChunk;
 
+        // State of COMPRESSION_GZIP_CHUNKED mode. When reading, the blocks of a chunk are read from the stream and
+        // decompressed when the chunk is first requested and _buffer is a view of the current chunk. The stream has to
+        // stay open until every chunk has been read or ReadCompressedData has been called. When writing, _buffer only
+        // holds the chunk being written.
+        std::vector<BlockEntry> _blocks;
+        std::vector<uint64_t> _blockOffsets;
+        std::vector<ChunkBlocks> _chunkBlocks;
+        std::vector<uint8_t> _compressedData;
+        uint64_t _compressedDataPosition{};
+        bool _compressedDataInMemory{};
+        uint64_t _bufferOffset{};
+        std::unique_ptr<Crypt::FNV1aAlgorithm> _hash;
+        std::unique_ptr<JobPool> _jobPool;
+
     public:
         OrcaStream(IStream& stream, const Mode mode)
         {
@@ -85,6 +130,12 @@ namespace OpenRCT2
                     _chunks.push_back(entry);
                 }
 
+                if (_header.Compression == COMPRESSION_GZIP_CHUNKED)
+                {
+                    ReadBlocks();
+                    return;
+                }
+
                 // Read compressed data into buffer (read in blocks)
                 _buffer = MemoryStream{};
                 uint8_t temp[2048];
@@ -112,9 +163,10 @@ namespace OpenRCT2
             else
             {
                 _header = {};
-                _header.Compression = COMPRESSION_GZIP;
+                _header.Compression = COMPRESSION_GZIP_CHUNKED;
 
                 _buffer = MemoryStream{};
+                _hash = Crypt::CreateFNV1a();
             }
         }
 
@@ -122,7 +174,11 @@ namespace OpenRCT2
 
         ~OrcaStream()
         {
-            if (_mode == Mode::WRITING)
+            if (_mode == Mode::WRITING && _header.Compression == COMPRESSION_GZIP_CHUNKED)
+            {
+                WriteBlocks();
+            }
+            else if (_mode == Mode::WRITING)
             {
                 const void* uncompressedData = _buffer.GetData();
                 const uint64_t uncompressedSize = _buffer.GetLength();
@@ -196,22 +252,98 @@ namespace OpenRCT2
                 return false;
             }
 
+            const auto chunkStart = _buffer.GetPosition();
             _currentChunk.Id = chunkId;
-            _currentChunk.Offset = _buffer.GetPosition();
+            _currentChunk.Offset = _bufferOffset + chunkStart;
             _currentChunk.Length = 0;
             ChunkStream stream(_buffer, _mode);
             f(stream);
-            _currentChunk.Length = static_cast<uint64_t>(_buffer.GetPosition()) - _currentChunk.Offset;
+            _currentChunk.Length = static_cast<uint64_t>(_buffer.GetPosition()) - chunkStart;
             _chunks.push_back(_currentChunk);
+            if (_header.Compression == COMPRESSION_GZIP_CHUNKED)
+            {
+                CompressChunk();
+            }
             return true;
         }
 
+        /**
+         * Decompresses all chunks that have not been read yet in parallel, only needed when every chunk is going to be
+         * read as they are otherwise decompressed one at a time when first accessed.
+         */
+        void DecompressAllChunks()
+        {
+            if (_mode != Mode::READING || _header.Compression != COMPRESSION_GZIP_CHUNKED)
+                return;
+
+            std::vector<size_t> pendingChunks;
+            for (size_t i = 0; i < _chunkBlocks.size(); i++)
+            {
+                if (!_chunkBlocks[i].Loaded)
+                {
+                    pendingChunks.push_back(i);
+                }
+            }
+            DecompressChunks(pendingChunks);
+        }
+
+        /**
+         * Reads the compressed data of all chunks into memory so that the underlying stream is no longer needed, for
+         * streams that do not outlive the reading of the chunks.
+         */
+        void ReadCompressedData()
+        {
+            if (_mode != Mode::READING || _header.Compression != COMPRESSION_GZIP_CHUNKED || _compressedDataInMemory)
+                return;
+
+            _compressedData.resize(static_cast<size_t>(_header.CompressedSize));
+            _stream->SetPosition(_compressedDataPosition);
+            _stream->Read(_compressedData.data(), _compressedData.size());
+            _compressedDataInMemory = true;
+        }
+
+        /**
+         * Writes the header versions and every chunk of this stream to a stream that is being written, which compresses
+         * them with its own compression mode.
+         */
+        void CopyChunksTo(OrcaStream& dst)
+        {
+            DecompressAllChunks();
+
+            auto& dstHeader = dst.GetHeader();
+            dstHeader.Magic = _header.Magic;
+            dstHeader.TargetVersion = _header.TargetVersion;
+            dstHeader.MinVersion = _header.MinVersion;
+
+            for (size_t i = 0; i < _chunks.size(); i++)
+            {
+                const auto& chunk = _chunks[i];
+                const auto* data = _header.Compression == COMPRESSION_GZIP_CHUNKED
+                    ? _chunkBlocks[i].Data.data()
+                    : static_cast<const uint8_t*>(_buffer.GetData()) + chunk.Offset;
+                dst.ReadWriteChunk(chunk.Id, [&](ChunkStream& cs) { cs.Write(data, static_cast<size_t>(chunk.Length)); });
+            }
+        }
+
     private:
         bool SeekChunk(const uint32_t id)
         {
             const auto result = std::find_if(_chunks.begin(), _chunks.end(), [id](const ChunkEntry& e) { return e.Id == id; });
             if (result != _chunks.end())
             {
+                if (_header.Compression == COMPRESSION_GZIP_CHUNKED)
+                {
+                    const auto chunkIndex = static_cast<size_t>(std::distance(_chunks.begin(), result));
+                    if (!_chunkBlocks[chunkIndex].Loaded)
+                    {
+                        DecompressChunks({ chunkIndex });
+                    }
+
+                    auto& data = _chunkBlocks[chunkIndex].Data;
+                    _buffer = MemoryStream(data.data(), data.size(), MEMORY_ACCESS::READ);
+                    return true;
+                }
+
                 const auto offset = result->Offset;
                 _buffer.SetPosition(offset);
                 return true;
@@ -219,6 +351,188 @@ namespace OpenRCT2
             return false;
         }
 
+        JobPool& GetJobPool()
+        {
+            if (_jobPool == nullptr)
+            {
+                _jobPool = std::make_unique<JobPool>();
+            }
+            return *_jobPool;
+        }
+
+        /**
+         * Runs fn for every index in [0, count), in parallel when there is more than one. Exceptions can not leave the
+         * pool's threads so the first one is caught and rethrown here after all calls have finished.
+         */
+        template<typename TFn> void ForEachBlock(size_t count, TFn&& fn)
+        {
+            if (count == 0)
+                return;
+            if (count == 1)
+            {
+                fn(0);
+                return;
+            }
+
+            std::atomic_bool failed = { false };
+            std::exception_ptr exception;
+            GetJobPool().ParallelFor(count, [&](size_t index) {
+                try
+                {
+                    fn(index);
+                }
+                catch (...)
+                {
+                    if (!failed.exchange(true))
+                    {
+                        exception = std::current_exception();
+                    }
+                }
+            });
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+
+        void ReadBlocks()
+        {
+            // Block table, the blocks of each chunk cover exactly the chunk's uncompressed length
+            uint64_t uncompressedEnd = 0;
+            for (const auto& chunk : _chunks)
+            {
+                ChunkBlocks chunkBlocks{ _blocks.size(), 0, false, {} };
+                uint64_t blockOffset = 0;
+                uint64_t bytesLeft = chunk.Length;
+                while (bytesLeft > 0)
+                {
+                    auto block = _stream->ReadValue<BlockEntry>();
+                    if (block.UncompressedLength == 0 || block.UncompressedLength > bytesLeft)
+                    {
+                        throw IOException("Invalid block table.");
+                    }
+                    _blocks.push_back(block);
+                    _blockOffsets.push_back(blockOffset);
+                    blockOffset += block.UncompressedLength;
+                    bytesLeft -= block.UncompressedLength;
+                    chunkBlocks.Count++;
+                }
+                _chunkBlocks.push_back(std::move(chunkBlocks));
+                uncompressedEnd = std::max(uncompressedEnd, chunk.Offset + chunk.Length);
+            }
+            if (uncompressedEnd > _header.UncompressedSize)
+            {
+                throw IOException("Chunk table exceeds uncompressed size.");
+            }
+            for (const auto& block : _blocks)
+            {
+                if (block.Offset > _header.CompressedSize || block.CompressedLength > _header.CompressedSize - block.Offset)
+                {
+                    throw IOException("Block table exceeds compressed size.");
+                }
+            }
+
+            // The compressed data is left in the stream until a chunk is read
+            _compressedDataPosition = _stream->GetPosition();
+            if (_stream->GetLength() - _compressedDataPosition < _header.CompressedSize)
+            {
+                throw IOException("Compressed data is truncated.");
+            }
+        }
+
+        void DecompressChunks(const std::vector<size_t>& chunkIndices)
+        {
+            struct PendingBlock
+            {
+                const BlockEntry* Block;
+                uint8_t* Destination;
+                std::vector<uint8_t> CompressedData;
+            };
+
+            // Blocks are read from the stream one after another, only decompression runs in parallel
+            std::vector<PendingBlock> pendingBlocks;
+            for (auto chunkIndex : chunkIndices)
+            {
+                auto& chunkBlocks = _chunkBlocks[chunkIndex];
+                chunkBlocks.Data.resize(static_cast<size_t>(_chunks[chunkIndex].Length));
+                chunkBlocks.Loaded = true;
+                for (size_t i = 0; i < chunkBlocks.Count; i++)
+                {
+                    const auto blockIndex = chunkBlocks.First + i;
+                    const auto& block = _blocks[blockIndex];
+                    PendingBlock pendingBlock{ &block, chunkBlocks.Data.data() + _blockOffsets[blockIndex], {} };
+                    if (!_compressedDataInMemory)
+                    {
+                        pendingBlock.CompressedData.resize(block.CompressedLength);
+                        _stream->SetPosition(_compressedDataPosition + block.Offset);
+                        _stream->Read(pendingBlock.CompressedData.data(), pendingBlock.CompressedData.size());
+                    }
+                    pendingBlocks.push_back(std::move(pendingBlock));
+                }
+            }
+
+            ForEachBlock(pendingBlocks.size(), [&](size_t index) {
+                const auto& pendingBlock = pendingBlocks[index];
+                const auto& block = *pendingBlock.Block;
+                const auto* compressedData = _compressedDataInMemory ? _compressedData.data() + block.Offset
+                                                                     : pendingBlock.CompressedData.data();
+                auto data = Ungzip(compressedData, block.CompressedLength);
+                if (data.size() != block.UncompressedLength)
+                {
+                    throw IOException("Block decompressed to an unexpected size.");
+                }
+                std::memcpy(pendingBlock.Destination, data.data(), data.size());
+            });
+        }
+
+        void CompressChunk()
+        {
+            const auto* data = static_cast<const uint8_t*>(_buffer.GetData());
+            const auto length = static_cast<size_t>(_buffer.GetLength());
+            _hash->Update(data, length);
+
+            const auto numBlocks = (length + kBlockSize - 1) / kBlockSize;
+            std::vector<std::vector<uint8_t>> compressedBlocks(numBlocks);
+            ForEachBlock(numBlocks, [&](size_t index) {
+                const auto offset = index * kBlockSize;
+                compressedBlocks[index] = Gzip(data + offset, std::min(kBlockSize, length - offset));
+            });
+
+            for (size_t i = 0; i < numBlocks; i++)
+            {
+                const auto& compressedBlock = compressedBlocks[i];
+                BlockEntry block;
+                block.Offset = _compressedData.size();
+                block.CompressedLength = static_cast<uint32_t>(compressedBlock.size());
+                block.UncompressedLength = static_cast<uint32_t>(std::min(kBlockSize, length - i * kBlockSize));
+                _blocks.push_back(block);
+                _compressedData.insert(_compressedData.end(), compressedBlock.begin(), compressedBlock.end());
+            }
+
+            // Only the compressed chunk is kept, the next chunk reuses the buffer
+            _bufferOffset += length;
+            _buffer.Clear();
+        }
+
+        void WriteBlocks()
+        {
+            _header.NumChunks = static_cast<uint32_t>(_chunks.size());
+            _header.UncompressedSize = _bufferOffset;
+            _header.CompressedSize = _compressedData.size();
+            _header.FNV1a = _hash->Finish();
+
+            _stream->WriteValue(_header);
+            for (const auto& chunk : _chunks)
+            {
+                _stream->WriteValue(chunk);
+            }
+            for (const auto& block : _blocks)
+            {
+                _stream->WriteValue(block);
+            }
+            _stream->Write(_compressedData.data(), _compressedData.size());
+        }
+
     public:
         class ChunkStream
         {
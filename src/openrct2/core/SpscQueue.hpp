@@ -0,0 +1,89 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace OpenRCT2
+{
+    /**
+     * Unbounded lock-free queue for passing values from exactly one producer thread to exactly one consumer thread.
+     * The queue is a linked list that always contains a stub node at the head, so the producer and the consumer never
+     * touch the same node except through its atomic next pointer.
+     */
+    template<typename T> class SpscQueue
+    {
+    private:
+        struct Node
+        {
+            std::atomic<Node*> Next = { nullptr };
+            T Value{};
+        };
+
+        // Only accessed by the consumer.
+        Node* _head;
+        // Only accessed by the producer.
+        Node* _tail;
+        std::atomic<size_t> _size = { 0 };
+
+    public:
+        SpscQueue()
+            : _head(new Node())
+            , _tail(_head)
+        {
+        }
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        ~SpscQueue()
+        {
+            while (_head != nullptr)
+            {
+                auto* next = _head->Next.load(std::memory_order_relaxed);
+                delete _head;
+                _head = next;
+            }
+        }
+
+        // Producer only.
+        void Push(T&& value)
+        {
+            auto* node = new Node();
+            node->Value = std::move(value);
+            _tail->Next.store(node, std::memory_order_release);
+            _tail = node;
+            _size.fetch_add(1, std::memory_order_release);
+        }
+
+        // Consumer only.
+        bool TryPop(T& value)
+        {
+            auto* next = _head->Next.load(std::memory_order_acquire);
+            if (next == nullptr)
+                return false;
+
+            // The popped node becomes the new stub.
+            value = std::move(next->Value);
+            delete _head;
+            _head = next;
+            _size.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+
+        // Number of queued values, may be out of date by the time it is used when called from the other thread.
+        size_t GetSize() const
+        {
+            return _size.load(std::memory_order_acquire);
+        }
+    };
+} // namespace OpenRCT2
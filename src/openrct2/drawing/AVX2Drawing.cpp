@@ -42,6 +42,61 @@ void MaskAvx2(
     }
 }
 
+template<DrawBlendOp TBlendOp>
+static void BlitRowAvx2(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap)
+{
+    const __m256i zero = {};
+    int32_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        __m256i colour;
+        if constexpr ((TBlendOp & (BLEND_SRC | BLEND_DST)) == 0)
+        {
+            colour = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        }
+        else
+        {
+            // There is no byte gather, look up the colours one by one but blend them into the row branch-free
+            alignas(32) uint8_t colours[32];
+            for (int32_t j = 0; j < 32; j++)
+            {
+                colours[j] = BlitPixelColour<TBlendOp>(src[i + j], dst[i + j], paletteMap);
+            }
+            colour = _mm256_load_si256(reinterpret_cast<const __m256i*>(colours));
+        }
+        const __m256i dest = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i transparent = _mm256_cmpeq_epi8(colour, zero);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(colour, dest, transparent));
+    }
+    for (; i < count; i++)
+    {
+        BlitPixel<TBlendOp>(src + i, dst + i, paletteMap);
+    }
+}
+
+void BlitRowAvx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap, DrawBlendOp blendOp)
+{
+    switch (blendOp)
+    {
+        case BLEND_TRANSPARENT:
+            BlitRowAvx2<BLEND_TRANSPARENT>(src, dst, count, paletteMap);
+            break;
+        case BLEND_TRANSPARENT | BLEND_SRC:
+            BlitRowAvx2<BLEND_TRANSPARENT | BLEND_SRC>(src, dst, count, paletteMap);
+            break;
+        case BLEND_TRANSPARENT | BLEND_DST:
+            BlitRowAvx2<BLEND_TRANSPARENT | BLEND_DST>(src, dst, count, paletteMap);
+            break;
+        case BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST:
+            BlitRowAvx2<BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST>(src, dst, count, paletteMap);
+            break;
+        default:
+            BlitRowScalar(src, dst, count, paletteMap, blendOp);
+            break;
+    }
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -55,4 +110,10 @@ void MaskAvx2(
     Guard::Fail("AVX2 function called on a CPU that doesn't support AVX2");
 }
 
+void BlitRowAvx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap, DrawBlendOp blendOp)
+{
+    Guard::Fail("AVX2 function called on a CPU that doesn't support AVX2");
+}
+
 #endif // __AVX2__
@@ -47,6 +47,17 @@ template<DrawBlendOp TBlendOp> static void FASTCALL DrawBMPSpriteMinify(DrawPixe
     size_t srcLineWidth = zoomLevel.ApplyTo(g1.width);
     size_t dstLineWidth = zoomLevel.ApplyInversedTo(static_cast<size_t>(dpi.width)) + dpi.pitch;
     uint8_t zoom = zoomLevel.ApplyTo(1);
+    if (zoom == 1)
+    {
+        // Rows are contiguous at this zoom level, blit them at once
+        for (; height > 0; height--)
+        {
+            BlitRowFn(src, dst, width, paletteMap, TBlendOp);
+            src += srcLineWidth;
+            dst += dstLineWidth;
+        }
+        return;
+    }
     for (; height > 0; height -= zoom)
     {
         auto nextSrc = src + srcLineWidth;
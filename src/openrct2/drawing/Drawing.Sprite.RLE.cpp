@@ -163,6 +163,14 @@ static void FASTCALL DrawRLESpriteMinify(DrawPixelInfo& dpi, const DrawSpriteArg
                     std::memcpy(dst, src, numPixels);
                 }
             }
+            else if constexpr (TZoom == 0)
+            {
+                // Pixels are contiguous at this zoom level, blit the whole run at once
+                if (numPixels > 0)
+                {
+                    BlitRowFn(src, dst, numPixels, args.PalMap, TBlendOp);
+                }
+            }
             else
             {
                 auto& paletteMap = args.PalMap;
@@ -14,6 +14,7 @@
 #include "../PlatformEnvironment.h"
 #include "../config/Config.h"
 #include "../core/FileStream.h"
+#include "../core/Guard.hpp"
 #include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../platform/Platform.h"
@@ -23,6 +24,7 @@
 #include "ScrollingText.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
 #include <vector>
@@ -180,6 +182,44 @@ void MaskScalar(
     }
 }
 
+template<DrawBlendOp TBlendOp>
+static void BlitRowScalar(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        BlitPixel<TBlendOp>(src + i, dst + i, paletteMap);
+    }
+}
+
+void BlitRowScalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap, DrawBlendOp blendOp)
+{
+    switch (blendOp)
+    {
+        case BLEND_NONE:
+            if (count > 0)
+            {
+                std::memcpy(dst, src, count);
+            }
+            break;
+        case BLEND_TRANSPARENT:
+            BlitRowScalar<BLEND_TRANSPARENT>(src, dst, count, paletteMap);
+            break;
+        case BLEND_TRANSPARENT | BLEND_SRC:
+            BlitRowScalar<BLEND_TRANSPARENT | BLEND_SRC>(src, dst, count, paletteMap);
+            break;
+        case BLEND_TRANSPARENT | BLEND_DST:
+            BlitRowScalar<BLEND_TRANSPARENT | BLEND_DST>(src, dst, count, paletteMap);
+            break;
+        case BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST:
+            BlitRowScalar<BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST>(src, dst, count, paletteMap);
+            break;
+        default:
+            Guard::Fail("Unsupported blend op %d", blendOp);
+            break;
+    }
+}
+
 static Gx _g1 = {};
 static Gx _g2 = {};
 static Gx _csg = {};
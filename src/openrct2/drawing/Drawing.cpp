@@ -18,6 +18,7 @@
 #include "../object/Object.h"
 #include "../object/ObjectEntryManager.h"
 #include "../object/WaterEntry.h"
+#include "../paint/PaintCache.h"
 #include "../platform/Platform.h"
 #include "../sprites.h"
 #include "../util/Util.h"
@@ -59,28 +60,6 @@ uint8_t& PaletteMap::operator[](size_t index)
     return _data[index];
 }
 
-uint8_t PaletteMap::operator[](size_t index) const
-{
-    assert(index < _dataLength);
-
-    // Provide safety in release builds
-    if (index >= _dataLength)
-    {
-        return 0;
-    }
-
-    return _data[index];
-}
-
-uint8_t PaletteMap::Blend(uint8_t src, uint8_t dst) const
-{
-    // src = 0 would be transparent so there is no blend palette for that, hence (src - 1)
-    assert(src != 0 && (src - 1) < _numMaps);
-    assert(dst < _mapLength);
-    auto idx = ((src - 1) * 256) + dst;
-    return (*this)[idx];
-}
-
 void PaletteMap::Copy(size_t dstIndex, const PaletteMap& src, size_t srcIndex, size_t length)
 {
     auto maxLength = std::min(_mapLength - srcIndex, _mapLength - dstIndex);
@@ -737,6 +716,33 @@ void MaskFn(
     MaskFunc(width, height, maskSrc, colourSrc, dst, maskWrap, colourWrap, dstWrap);
 }
 
+static auto GetBlitRowFunction()
+{
+    if (AVX2Available())
+    {
+        LOG_VERBOSE("registering AVX2 blit row function");
+        return BlitRowAvx2;
+    }
+    else if (SSE41Available())
+    {
+        LOG_VERBOSE("registering SSE4.1 blit row function");
+        return BlitRowSse4_1;
+    }
+    else
+    {
+        LOG_VERBOSE("registering scalar blit row function");
+        return BlitRowScalar;
+    }
+}
+
+static const auto BlitRowFunc = GetBlitRowFunction();
+
+void BlitRowFn(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap, DrawBlendOp blendOp)
+{
+    BlitRowFunc(src, dst, count, paletteMap, blendOp);
+}
+
 void GfxFilterPixel(DrawPixelInfo& dpi, const ScreenCoordsXY& coords, FilterPaletteID palette)
 {
     GfxFilterRect(dpi, { coords, coords }, palette);
@@ -817,6 +823,7 @@ void LoadPalette()
  */
 void GfxInvalidateScreen()
 {
+    PaintCacheInvalidateAll();
     GfxSetDirtyBlocks({ { 0, 0 }, { ContextGetWidth(), ContextGetHeight() } });
 }
 
@@ -18,6 +18,7 @@
 #include "ImageId.hpp"
 #include "Text.h"
 
+#include <cassert>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -401,8 +402,30 @@ public:
     }
 
     uint8_t& operator[](size_t index);
-    uint8_t operator[](size_t index) const;
-    uint8_t Blend(uint8_t src, uint8_t dst) const;
+
+    // Inline as these are called for every pixel of a remapped sprite
+    uint8_t operator[](size_t index) const
+    {
+        assert(index < _dataLength);
+
+        // Provide safety in release builds
+        if (index >= _dataLength)
+        {
+            return 0;
+        }
+
+        return _data[index];
+    }
+
+    uint8_t Blend(uint8_t src, uint8_t dst) const
+    {
+        // src = 0 would be transparent so there is no blend palette for that, hence (src - 1)
+        assert(src != 0 && (src - 1) < _numMaps);
+        assert(dst < _mapLength);
+        auto idx = ((src - 1) * 256) + dst;
+        return (*this)[idx];
+    }
+
     void Copy(size_t dstIndex, const PaletteMap& src, size_t srcIndex, size_t length);
 };
 
@@ -489,6 +512,38 @@ template<DrawBlendOp TBlendOp> bool FASTCALL BlitPixel(const uint8_t* src, uint8
     }
 }
 
+/**
+ * Returns the colour BlitPixel writes for the given source and destination pixel, or 0 if a transparent blend op
+ * leaves the destination pixel untouched.
+ */
+template<DrawBlendOp TBlendOp> uint8_t FASTCALL BlitPixelColour(uint8_t src, uint8_t dst, const PaletteMap& paletteMap)
+{
+    if constexpr (TBlendOp & BLEND_TRANSPARENT)
+    {
+        if (src == 0)
+        {
+            return 0;
+        }
+    }
+
+    if constexpr (((TBlendOp & BLEND_SRC) != 0) && ((TBlendOp & BLEND_DST) != 0))
+    {
+        return paletteMap.Blend(src, dst);
+    }
+    else if constexpr ((TBlendOp & BLEND_SRC) != 0)
+    {
+        return paletteMap[src];
+    }
+    else if constexpr ((TBlendOp & BLEND_DST) != 0)
+    {
+        return paletteMap[dst];
+    }
+    else
+    {
+        return src;
+    }
+}
+
 template<DrawBlendOp TBlendOp>
 void FASTCALL BlitPixels(const uint8_t* src, uint8_t* dst, const PaletteMap& paletteMap, uint8_t zoom, size_t dstPitch)
 {
@@ -628,6 +683,20 @@ void MaskFn(
     int32_t width, int32_t height, const uint8_t* RESTRICT maskSrc, const uint8_t* RESTRICT colourSrc, uint8_t* RESTRICT dst,
     int32_t maskWrap, int32_t colourWrap, int32_t dstWrap);
 
+/**
+ * Blits count contiguous pixels of a sprite row at zoom level 0, the result is identical to calling BlitPixel for every
+ * pixel. Supports BLEND_NONE and the combinations of BLEND_TRANSPARENT that sprites are drawn with.
+ */
+void BlitRowScalar(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap, DrawBlendOp blendOp);
+void BlitRowSse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap, DrawBlendOp blendOp);
+void BlitRowAvx2(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap, DrawBlendOp blendOp);
+
+void BlitRowFn(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap, DrawBlendOp blendOp);
+
 std::optional<uint32_t> GetPaletteG1Index(colour_t paletteId);
 std::optional<PaletteMap> GetPaletteMapForColour(colour_t paletteId);
 void UpdatePalette(const uint8_t* colours, int32_t start_index, int32_t num_colours);
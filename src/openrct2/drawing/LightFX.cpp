@@ -671,8 +671,14 @@ static void LightFXAdd3DLight(
     //  LOG_WARNING("new 3d light");
 }
 
+static thread_local std::vector<LightFXMapLight>* _mapLightRecording = nullptr;
+
 static void LightFXAdd3DLight(const CoordsXYZ& loc, const LightType lightType)
 {
+    if (_mapLightRecording != nullptr)
+    {
+        _mapLightRecording->push_back({ loc, lightType });
+    }
     LightFXAdd3DLight(((loc.x << 16) | loc.y), LightFXQualifier::Map, loc.z, loc, lightType);
 }
 
@@ -690,6 +696,33 @@ void LightFXAdd3DLightMagicFromDrawingTile(
     LightFXAdd3DLight({ x, y, offsetZ }, lightType);
 }
 
+void LightFXSetMapLightRecording(std::vector<LightFXMapLight>* lights)
+{
+    _mapLightRecording = lights;
+}
+
+void LightFXAddMapLights(const std::vector<LightFXMapLight>& lights)
+{
+    for (const auto& light : lights)
+    {
+        LightFXAdd3DLight(light.Position, light.Type);
+    }
+}
+
+std::vector<LightFXMapLight> LightFXGetFrontMapLights()
+{
+    std::vector<LightFXMapLight> lights;
+    for (uint32_t i = 0; i < LightListCurrentCountFront; i++)
+    {
+        const auto& entry = _LightListFront[i];
+        if (entry.Qualifier == LightFXQualifier::Map)
+        {
+            lights.push_back({ entry.Position, entry.Type });
+        }
+    }
+    return lights;
+}
+
 uint32_t LightFXGetLightPolution()
 {
     return _lightPolution_front;
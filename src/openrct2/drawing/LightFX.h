@@ -10,12 +10,13 @@
 #pragma once
 
 #include "../common.h"
+#include "../world/Location.hpp"
+
+#include <vector>
 
-struct CoordsXY;
 struct Vehicle;
 struct DrawPixelInfo;
 struct GamePalette;
-struct CoordsXYZ;
 struct EntityBase;
 
 enum class LightType : uint8_t
@@ -42,6 +43,18 @@ constexpr LightType SetLightTypeSize(LightType type, uint8_t size)
     return static_cast<LightType>(((static_cast<uint8_t>(type) & ~0x3) | size));
 }
 
+// A light added at a map position by the paint functions of a tile element.
+struct LightFXMapLight
+{
+    CoordsXYZ Position;
+    LightType Type;
+
+    bool operator==(const LightFXMapLight& other) const
+    {
+        return Position == other.Position && Type == other.Type;
+    }
+};
+
 void LightFXSetAvailable(bool available);
 bool LightFXIsAvailable();
 bool LightFXForVehiclesIsAvailable();
@@ -63,6 +76,12 @@ void LightFXAdd3DLight(const EntityBase& entity, const uint8_t id, const CoordsX
 void LightFXAdd3DLightMagicFromDrawingTile(
     const CoordsXY& mapPosition, int16_t offsetX, int16_t offsetY, int16_t offsetZ, LightType lightType);
 
+// While set, map lights added on the calling thread are also appended to lights, so they can be added again without
+// painting the tile elements that added them.
+void LightFXSetMapLightRecording(std::vector<LightFXMapLight>* lights);
+void LightFXAddMapLights(const std::vector<LightFXMapLight>& lights);
+std::vector<LightFXMapLight> LightFXGetFrontMapLights();
+
 void LightFXAddLightsMagicVehicle(const Vehicle* vehicle);
 void LightFxAddLightsMagicVehicle_ObservationTower(const Vehicle* vehicle);
 void LightFxAddLightsMagicVehicle_MineTrainCoaster(const Vehicle* vehicle);
@@ -56,6 +56,61 @@ void MaskSse4_1(
     }
 }
 
+template<DrawBlendOp TBlendOp>
+static void BlitRowSse4_1(const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap)
+{
+    const __m128i zero = {};
+    int32_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i colour;
+        if constexpr ((TBlendOp & (BLEND_SRC | BLEND_DST)) == 0)
+        {
+            colour = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        }
+        else
+        {
+            // There is no byte gather, look up the colours one by one but blend them into the row branch-free
+            alignas(16) uint8_t colours[16];
+            for (int32_t j = 0; j < 16; j++)
+            {
+                colours[j] = BlitPixelColour<TBlendOp>(src[i + j], dst[i + j], paletteMap);
+            }
+            colour = _mm_load_si128(reinterpret_cast<const __m128i*>(colours));
+        }
+        const __m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i transparent = _mm_cmpeq_epi8(colour, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(colour, dest, transparent));
+    }
+    for (; i < count; i++)
+    {
+        BlitPixel<TBlendOp>(src + i, dst + i, paletteMap);
+    }
+}
+
+void BlitRowSse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap, DrawBlendOp blendOp)
+{
+    switch (blendOp)
+    {
+        case BLEND_TRANSPARENT:
+            BlitRowSse4_1<BLEND_TRANSPARENT>(src, dst, count, paletteMap);
+            break;
+        case BLEND_TRANSPARENT | BLEND_SRC:
+            BlitRowSse4_1<BLEND_TRANSPARENT | BLEND_SRC>(src, dst, count, paletteMap);
+            break;
+        case BLEND_TRANSPARENT | BLEND_DST:
+            BlitRowSse4_1<BLEND_TRANSPARENT | BLEND_DST>(src, dst, count, paletteMap);
+            break;
+        case BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST:
+            BlitRowSse4_1<BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST>(src, dst, count, paletteMap);
+            break;
+        default:
+            BlitRowScalar(src, dst, count, paletteMap, blendOp);
+            break;
+    }
+}
+
 #else
 
 #    ifdef OPENRCT2_X86
@@ -69,4 +124,10 @@ void MaskSse4_1(
     Guard::Fail("SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+void BlitRowSse4_1(
+    const uint8_t* RESTRICT src, uint8_t* RESTRICT dst, int32_t count, const PaletteMap& paletteMap, DrawBlendOp blendOp)
+{
+    Guard::Fail("SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
 #endif // __SSE4_1__
@@ -17,12 +17,16 @@
 #include "../localisation/Localisation.h"
 #include "../localisation/LocalisationService.h"
 #include "../paint/Paint.h"
+#include "../profiling/Profiling.h"
 #include "../sprites.h"
 #include "Drawing.h"
 #include "TTF.h"
 
 #include <algorithm>
+#include <atomic>
 #include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 using namespace OpenRCT2;
 
@@ -33,14 +37,23 @@ struct DrawScrollText
     colour_t colour;
     uint16_t position;
     uint16_t mode;
-    uint32_t id;
+    uint64_t hash;
+    // Last use, updated by concurrent lookups
+    std::atomic<uint32_t> id;
     uint8_t bitmap[64 * 40];
 };
 
 static DrawScrollText _drawScrollTextList[OpenRCT2::MaxScrollingTextEntries];
 static uint8_t _characterBitmaps[FONT_SPRITE_GLYPH_COUNT + SPR_G2_GLYPH_COUNT][8];
-static uint32_t _drawSCrollNextIndex = 0;
-static std::mutex _scrollingTextMutex;
+static std::atomic<uint32_t> _drawSCrollNextIndex = 0;
+
+// Maps the hash of a scrolling text key to its index in _drawScrollTextList.
+// Lookups share the lock, only creating an entry takes it exclusively.
+static std::unordered_map<uint64_t, uint16_t> _drawScrollTextIndex;
+static std::shared_mutex _scrollingTextMutex;
+
+static Profiling::Counter _scrollingTextHits("ScrollingText cache hits");
+static Profiling::Counter _scrollingTextMisses("ScrollingText cache misses");
 
 static void ScrollingTextSetBitmapForSprite(
     std::string_view text, int32_t scroll, uint8_t* bitmap, const int16_t* scrollPositionOffsets, colour_t colour);
@@ -120,28 +133,55 @@ static uint8_t* FontSpriteGetCodepointBitmap(int32_t codepoint)
     return _characterBitmaps[offset];
 }
 
-static int32_t ScrollingTextGetMatchingOrOldest(
-    StringId stringId, Formatter& ft, uint16_t scroll, uint16_t scrollingMode, colour_t colour)
+static uint64_t ScrollingTextHash(
+    StringId stringId, const uint8_t* args, uint16_t scroll, uint16_t scrollingMode, colour_t colour)
+{
+    // FNV-1a
+    uint64_t hash = 0xCBF29CE484222325;
+    auto add = [&hash](const void* data, size_t length) {
+        auto bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < length; i++)
+        {
+            hash = (hash ^ bytes[i]) * 0x100000001B3;
+        }
+    };
+    add(&stringId, sizeof(stringId));
+    add(args, sizeof(DrawScrollText::string_args));
+    add(&scroll, sizeof(scroll));
+    add(&scrollingMode, sizeof(scrollingMode));
+    add(&colour, sizeof(colour));
+    return hash;
+}
+
+static int32_t ScrollingTextFind(
+    uint64_t hash, StringId stringId, const uint8_t* args, uint16_t scroll, uint16_t scrollingMode, colour_t colour)
+{
+    auto it = _drawScrollTextIndex.find(hash);
+    if (it == _drawScrollTextIndex.end())
+        return -1;
+
+    // Compare the whole key in case of a hash collision
+    const auto& scrollText = _drawScrollTextList[it->second];
+    if (scrollText.string_id == stringId && std::memcmp(scrollText.string_args, args, sizeof(scrollText.string_args)) == 0
+        && scrollText.colour == colour && scrollText.position == scroll && scrollText.mode == scrollingMode)
+    {
+        return it->second;
+    }
+    return -1;
+}
+
+static int32_t ScrollingTextGetOldest()
 {
     uint32_t oldestId = 0xFFFFFFFF;
-    int32_t scrollIndex = -1;
+    int32_t scrollIndex = 0;
     for (size_t i = 0; i < std::size(_drawScrollTextList); i++)
     {
-        DrawScrollText* scrollText = &_drawScrollTextList[i];
-        if (oldestId >= scrollText->id)
+        const auto id = _drawScrollTextList[i].id.load(std::memory_order_relaxed);
+        if (oldestId >= id)
         {
-            oldestId = scrollText->id;
+            oldestId = id;
             scrollIndex = static_cast<int32_t>(i);
         }
-
-        // If exact match return the matching index
-        if (scrollText->string_id == stringId
-            && std::memcmp(scrollText->string_args, ft.Buf(), sizeof(scrollText->string_args)) == 0
-            && scrollText->colour == colour && scrollText->position == scroll && scrollText->mode == scrollingMode)
-        {
-            scrollText->id = _drawSCrollNextIndex;
-            return static_cast<int32_t>(i + SPR_SCROLLING_TEXT_START);
-        }
     }
     return scrollIndex;
 }
@@ -1426,6 +1466,9 @@ static constexpr const int16_t* _scrollPositions[MAX_SCROLLING_TEXT_MODES] = {
 
 void ScrollingTextInvalidate()
 {
+    std::unique_lock<std::shared_mutex> lock(_scrollingTextMutex);
+
+    _drawScrollTextIndex.clear();
     for (auto& scrollText : _drawScrollTextList)
     {
         scrollText.string_id = 0;
@@ -1436,27 +1479,54 @@ void ScrollingTextInvalidate()
 ImageId ScrollingTextSetup(
     PaintSession& session, StringId stringId, Formatter& ft, uint16_t scroll, uint16_t scrollingMode, colour_t colour)
 {
-    std::scoped_lock<std::mutex> lock(_scrollingTextMutex);
-
     assert(scrollingMode < MAX_SCROLLING_TEXT_MODES);
 
     if (session.DPI.zoom_level > ZoomLevel{ 0 })
         return ImageId(SPR_SCROLLING_TEXT_DEFAULT);
 
-    _drawSCrollNextIndex++;
+    const auto frameId = ++_drawSCrollNextIndex;
     ft.Rewind();
-    int32_t scrollIndex = ScrollingTextGetMatchingOrOldest(stringId, ft, scroll, scrollingMode, colour);
-    if (scrollIndex >= SPR_SCROLLING_TEXT_START)
-        return ImageId(scrollIndex);
+    const auto* args = ft.Buf();
+    const auto hash = ScrollingTextHash(stringId, args, scroll, scrollingMode, colour);
+    {
+        std::shared_lock<std::shared_mutex> lock(_scrollingTextMutex);
+        auto scrollIndex = ScrollingTextFind(hash, stringId, args, scroll, scrollingMode, colour);
+        if (scrollIndex != -1)
+        {
+            _scrollingTextHits.Increment();
+            _drawScrollTextList[scrollIndex].id.store(frameId, std::memory_order_relaxed);
+            return ImageId(SPR_SCROLLING_TEXT_START + scrollIndex);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(_scrollingTextMutex);
 
-    // Setup scrolling text
+    // Another thread may have created the same text while the lock was released
+    auto scrollIndex = ScrollingTextFind(hash, stringId, args, scroll, scrollingMode, colour);
+    if (scrollIndex != -1)
+    {
+        _scrollingTextHits.Increment();
+        _drawScrollTextList[scrollIndex].id.store(frameId, std::memory_order_relaxed);
+        return ImageId(SPR_SCROLLING_TEXT_START + scrollIndex);
+    }
+    _scrollingTextMisses.Increment();
+
+    // Setup scrolling text in place of the least recently used one
+    scrollIndex = ScrollingTextGetOldest();
     auto scrollText = &_drawScrollTextList[scrollIndex];
+    auto oldEntry = _drawScrollTextIndex.find(scrollText->hash);
+    if (oldEntry != _drawScrollTextIndex.end() && oldEntry->second == scrollIndex)
+    {
+        _drawScrollTextIndex.erase(oldEntry);
+    }
     scrollText->string_id = stringId;
-    std::memcpy(scrollText->string_args, ft.Buf(), sizeof(scrollText->string_args));
+    std::memcpy(scrollText->string_args, args, sizeof(scrollText->string_args));
     scrollText->colour = colour;
     scrollText->position = scroll;
     scrollText->mode = scrollingMode;
-    scrollText->id = _drawSCrollNextIndex;
+    scrollText->hash = hash;
+    scrollText->id.store(frameId, std::memory_order_relaxed);
+    _drawScrollTextIndex.insert_or_assign(hash, static_cast<uint16_t>(scrollIndex));
 
     // Create the string to draw
     utf8 scrollString[256];
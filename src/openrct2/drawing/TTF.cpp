@@ -9,8 +9,13 @@
 
 #ifndef NO_TTF
 
+#    include <array>
 #    include <atomic>
+#    include <list>
 #    include <mutex>
+#    include <optional>
+#    include <unordered_map>
+#    include <utility>
 #    pragma clang diagnostic push
 #    pragma clang diagnostic ignored "-Wdocumentation"
 #    include <ft2build.h>
@@ -19,55 +24,22 @@
 
 #    include "../OpenRCT2.h"
 #    include "../config/Config.h"
-#    include "../core/Numerics.hpp"
 #    include "../core/String.hpp"
 #    include "../localisation/Localisation.h"
 #    include "../localisation/LocalisationService.h"
 #    include "../platform/Platform.h"
+#    include "../profiling/Profiling.h"
 #    include "TTF.h"
 
 static bool _ttfInitialised = false;
 
-#    define TTF_SURFACE_CACHE_SIZE 256
-#    define TTF_GETWIDTH_CACHE_SIZE 1024
-
-struct ttf_cache_entry
-{
-    TTFSurface* surface;
-    TTF_Font* font;
-    u8string text;
-    uint32_t lastUseTick;
-};
-
-struct ttf_getwidth_cache_entry
-{
-    uint32_t width;
-    TTF_Font* font;
-    u8string text;
-    uint32_t lastUseTick;
-};
-
-static ttf_cache_entry _ttfSurfaceCache[TTF_SURFACE_CACHE_SIZE] = {};
-static int32_t _ttfSurfaceCacheCount = 0;
-static int32_t _ttfSurfaceCacheHitCount = 0;
-static int32_t _ttfSurfaceCacheMissCount = 0;
-
-static ttf_getwidth_cache_entry _ttfGetWidthCache[TTF_GETWIDTH_CACHE_SIZE] = {};
-static int32_t _ttfGetWidthCacheCount = 0;
-static int32_t _ttfGetWidthCacheHitCount = 0;
-static int32_t _ttfGetWidthCacheMissCount = 0;
+// Default budget of the surface cache when none is configured
+static constexpr size_t kTTFSurfaceCacheDefaultSize = 8 * 1024 * 1024;
+static constexpr size_t kTTFGetWidthCacheSize = 512 * 1024;
+static constexpr size_t kTTFCacheShardCount = 8;
 
 static std::mutex _mutex;
 
-static TTF_Font* TTFOpenFont(const utf8* fontPath, int32_t ptSize);
-static void TTFCloseFont(TTF_Font* font);
-static void TTFSurfaceCacheDispose(ttf_cache_entry* entry);
-static void TTFSurfaceCacheDisposeAll();
-static void TTFGetWidthCacheDisposeAll();
-static bool TTFGetSize(TTF_Font* font, std::string_view text, int32_t* outWidth, int32_t* outHeight);
-static void TTFToggleHinting(bool);
-static TTFSurface* TTFRender(TTF_Font* font, std::string_view text);
-
 template<typename T> class FontLockHelper
 {
     T& _mutex;
@@ -88,6 +60,192 @@ public:
     }
 };
 
+static OpenRCT2::Profiling::Counter _ttfSurfaceCacheHits("TTF surface cache hits");
+static OpenRCT2::Profiling::Counter _ttfSurfaceCacheMisses("TTF surface cache misses");
+static OpenRCT2::Profiling::Counter _ttfGetWidthCacheHits("TTF width cache hits");
+static OpenRCT2::Profiling::Counter _ttfGetWidthCacheMisses("TTF width cache misses");
+
+/**
+ * Least recently used cache of values created for a font and text. The cache is split into shards by the hash of
+ * the key so threads drawing different strings rarely contend. Each shard evicts its least recently used entries
+ * once it holds more than its part of the byte budget, but never entries used during the current draw as those
+ * may still be in use by other threads.
+ */
+template<typename TValue> class TTFCache
+{
+private:
+    struct Entry
+    {
+        uint64_t Hash;
+        TTF_Font* Font;
+        u8string Text;
+        TValue Value;
+        size_t Size;
+        uint32_t LastUseTick;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    struct Shard
+    {
+        std::mutex Mutex;
+        EntryList Entries;
+        std::unordered_multimap<uint64_t, typename EntryList::iterator> Index;
+        size_t Size = 0;
+    };
+
+    std::array<Shard, kTTFCacheShardCount> _shards;
+    void (*const _dispose)(TValue&);
+    OpenRCT2::Profiling::Counter& _hits;
+    OpenRCT2::Profiling::Counter& _misses;
+
+    static uint64_t Hash(TTF_Font* font, std::string_view text)
+    {
+        // FNV-1a
+        uint64_t hash = 0xCBF29CE484222325 ^ static_cast<uint64_t>(reinterpret_cast<uintptr_t>(font));
+        for (auto c : text)
+        {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001B3;
+        }
+        return hash;
+    }
+
+    Shard& GetShard(uint64_t hash)
+    {
+        return _shards[(hash >> 32) % kTTFCacheShardCount];
+    }
+
+    // Finds the entry and marks it as most recently used, the shard must be locked.
+    static const Entry* Find(Shard& shard, uint64_t hash, TTF_Font* font, std::string_view text)
+    {
+        auto range = shard.Index.equal_range(hash);
+        for (auto it = range.first; it != range.second; it++)
+        {
+            auto& entry = *it->second;
+            if (entry.Font == font && entry.Text == text)
+            {
+                entry.LastUseTick = gCurrentDrawCount;
+                shard.Entries.splice(shard.Entries.begin(), shard.Entries, it->second);
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    void Erase(Shard& shard, typename EntryList::iterator entry)
+    {
+        auto range = shard.Index.equal_range(entry->Hash);
+        for (auto it = range.first; it != range.second; it++)
+        {
+            if (it->second == entry)
+            {
+                shard.Index.erase(it);
+                break;
+            }
+        }
+        shard.Size -= entry->Size;
+        _dispose(entry->Value);
+        shard.Entries.erase(entry);
+    }
+
+    void Evict(Shard& shard, size_t budget)
+    {
+        while (shard.Size > budget && !shard.Entries.empty())
+        {
+            auto it = std::prev(shard.Entries.end());
+            if (it->LastUseTick == gCurrentDrawCount)
+                break;
+            Erase(shard, it);
+        }
+    }
+
+public:
+    TTFCache(void (*dispose)(TValue&), OpenRCT2::Profiling::Counter& hits, OpenRCT2::Profiling::Counter& misses)
+        : _dispose(dispose)
+        , _hits(hits)
+        , _misses(misses)
+    {
+    }
+
+    /**
+     * Returns the cached value for the font and text. On a miss, create is called with the font lock held and must
+     * return the value together with its size in bytes, or std::nullopt if nothing could be created.
+     */
+    template<typename TCreate>
+    std::optional<TValue> GetOrAdd(TTF_Font* font, std::string_view text, size_t budget, TCreate&& create)
+    {
+        const auto hash = Hash(font, text);
+        auto& shard = GetShard(hash);
+        {
+            std::scoped_lock<std::mutex> lock(shard.Mutex);
+            if (auto* entry = Find(shard, hash, font, text); entry != nullptr)
+            {
+                _hits.Increment();
+                return entry->Value;
+            }
+        }
+
+        // FreeType fonts must not be used by multiple threads at once
+        std::optional<std::pair<TValue, size_t>> created;
+        {
+            FontLockHelper<std::mutex> fontLock(_mutex);
+            created = create();
+        }
+        if (!created.has_value())
+            return std::nullopt;
+
+        std::scoped_lock<std::mutex> lock(shard.Mutex);
+        if (auto* entry = Find(shard, hash, font, text); entry != nullptr)
+        {
+            // Another thread created the same value in the meantime
+            _hits.Increment();
+            _dispose(created->first);
+            return entry->Value;
+        }
+        _misses.Increment();
+
+        shard.Entries.push_front({ hash, font, u8string(text), created->first, created->second, gCurrentDrawCount });
+        shard.Index.emplace(hash, shard.Entries.begin());
+        shard.Size += created->second;
+        Evict(shard, budget / kTTFCacheShardCount);
+        return created->first;
+    }
+
+    void Clear()
+    {
+        for (auto& shard : _shards)
+        {
+            std::scoped_lock<std::mutex> lock(shard.Mutex);
+            for (auto& entry : shard.Entries)
+            {
+                _dispose(entry.Value);
+            }
+            shard.Entries.clear();
+            shard.Index.clear();
+            shard.Size = 0;
+        }
+    }
+};
+
+static void TTFSurfaceCacheDispose(TTFSurface*& surface)
+{
+    TTFFreeSurface(surface);
+    surface = nullptr;
+}
+
+static void TTFGetWidthCacheDispose(uint32_t&)
+{
+}
+
+static TTFCache<TTFSurface*> _ttfSurfaceCache(TTFSurfaceCacheDispose, _ttfSurfaceCacheHits, _ttfSurfaceCacheMisses);
+static TTFCache<uint32_t> _ttfGetWidthCache(TTFGetWidthCacheDispose, _ttfGetWidthCacheHits, _ttfGetWidthCacheMisses);
+
+static TTF_Font* TTFOpenFont(const utf8* fontPath, int32_t ptSize);
+static void TTFCloseFont(TTF_Font* font);
+static bool TTFGetSize(TTF_Font* font, std::string_view text, int32_t* outWidth, int32_t* outHeight);
+static void TTFToggleHinting(bool);
+static TTFSurface* TTFRender(TTF_Font* font, std::string_view text);
+
 static void TTFToggleHinting(bool)
 {
     if (!LocalisationService_UseTrueTypeFont())
@@ -102,10 +260,7 @@ static void TTFToggleHinting(bool)
         TTF_SetFontHinting(fontDesc->font, use_hinting ? 1 : 0);
     }
 
-    if (_ttfSurfaceCacheCount)
-    {
-        TTFSurfaceCacheDisposeAll();
-    }
+    _ttfSurfaceCache.Clear();
 }
 
 bool TTFInitialise()
@@ -154,8 +309,8 @@ void TTFDispose()
     if (!_ttfInitialised)
         return;
 
-    TTFSurfaceCacheDisposeAll();
-    TTFGetWidthCacheDisposeAll();
+    _ttfSurfaceCache.Clear();
+    _ttfGetWidthCache.Clear();
 
     for (int32_t i = 0; i < FontStyleCount; i++)
     {
@@ -182,165 +337,44 @@ static void TTFCloseFont(TTF_Font* font)
     TTF_CloseFont(font);
 }
 
-static uint32_t TTFSurfaceCacheHash(TTF_Font* font, std::string_view text)
-{
-    uint32_t hash = static_cast<uint32_t>(((reinterpret_cast<uintptr_t>(font) * 23) ^ 0xAAAAAAAA) & 0xFFFFFFFF);
-    for (auto c : text)
-    {
-        hash = Numerics::ror32(hash, 3) ^ (c * 13);
-    }
-    return hash;
-}
-
-static void TTFSurfaceCacheDispose(ttf_cache_entry* entry)
-{
-    if (entry->surface != nullptr)
-    {
-        TTFFreeSurface(entry->surface);
-        entry->text.clear();
-        entry->surface = nullptr;
-        entry->font = nullptr;
-    }
-}
-
-static void TTFSurfaceCacheDisposeAll()
-{
-    for (int32_t i = 0; i < TTF_SURFACE_CACHE_SIZE; i++)
-    {
-        TTFSurfaceCacheDispose(&_ttfSurfaceCache[i]);
-        _ttfSurfaceCacheCount--;
-    }
-}
-
 void TTFToggleHinting()
 {
     FontLockHelper<std::mutex> lock(_mutex);
     TTFToggleHinting(true);
 }
 
-TTFSurface* TTFSurfaceCacheGetOrAdd(TTF_Font* font, std::string_view text)
+static size_t TTFGetSurfaceCacheSize()
 {
-    ttf_cache_entry* entry;
-
-    uint32_t hash = TTFSurfaceCacheHash(font, text);
-    int32_t index = hash % TTF_SURFACE_CACHE_SIZE;
-
-    FontLockHelper<std::mutex> lock(_mutex);
-
-    for (int32_t i = 0; i < TTF_SURFACE_CACHE_SIZE; i++)
+    if (gConfigFonts.CacheSize > 0)
     {
-        entry = &_ttfSurfaceCache[index];
-
-        // Check if entry is a hit
-        if (entry->surface == nullptr)
-            break;
-        if (entry->font == font && String::Equals(entry->text, text))
-        {
-            _ttfSurfaceCacheHitCount++;
-            entry->lastUseTick = gCurrentDrawCount;
-            return entry->surface;
-        }
-
-        // If entry hasn't been used for a while, replace it
-        if (entry->lastUseTick < gCurrentDrawCount - 64)
-        {
-            break;
-        }
-
-        // Check if next entry is a hit
-        if (++index >= TTF_SURFACE_CACHE_SIZE)
-            index = 0;
+        return static_cast<size_t>(gConfigFonts.CacheSize) * 1024;
     }
-
-    // Cache miss, replace entry with new surface
-    entry = &_ttfSurfaceCache[index];
-    TTFSurfaceCacheDispose(entry);
-
-    TTFSurface* surface = TTFRender(font, text);
-    if (surface == nullptr)
-    {
-        return nullptr;
-    }
-
-    _ttfSurfaceCacheMissCount++;
-    // printf("CACHE HITS: %d   MISSES: %d)\n", _ttfSurfaceCacheHitCount, _ttfSurfaceCacheMissCount);
-
-    _ttfSurfaceCacheCount++;
-    entry->surface = surface;
-    entry->font = font;
-    entry->text = text;
-    entry->lastUseTick = gCurrentDrawCount;
-    return entry->surface;
+    return kTTFSurfaceCacheDefaultSize;
 }
 
-static void TTFGetWidthCacheDispose(ttf_getwidth_cache_entry* entry)
-{
-    if (entry->text.empty())
-        return;
-
-    entry->text.clear();
-    entry->width = 0;
-    entry->font = nullptr;
-}
-
-static void TTFGetWidthCacheDisposeAll()
+TTFSurface* TTFSurfaceCacheGetOrAdd(TTF_Font* font, std::string_view text)
 {
-    for (int32_t i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++)
-    {
-        TTFGetWidthCacheDispose(&_ttfGetWidthCache[i]);
-        _ttfGetWidthCacheCount--;
-    }
+    auto surface = _ttfSurfaceCache.GetOrAdd(
+        font, text, TTFGetSurfaceCacheSize(), [font, text]() -> std::optional<std::pair<TTFSurface*, size_t>> {
+            TTFSurface* newSurface = TTFRender(font, text);
+            if (newSurface == nullptr)
+                return std::nullopt;
+
+            const auto size = sizeof(TTFSurface) + text.size() + static_cast<size_t>(newSurface->pitch) * newSurface->h;
+            return std::make_pair(newSurface, size);
+        });
+    return surface.value_or(nullptr);
 }
 
 uint32_t TTFGetWidthCacheGetOrAdd(TTF_Font* font, std::string_view text)
 {
-    ttf_getwidth_cache_entry* entry;
-
-    uint32_t hash = TTFSurfaceCacheHash(font, text);
-    int32_t index = hash % TTF_GETWIDTH_CACHE_SIZE;
-
-    FontLockHelper<std::mutex> lock(_mutex);
-
-    for (int32_t i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++)
-    {
-        entry = &_ttfGetWidthCache[index];
-
-        // Check if entry is a hit
-        if (entry->text.empty())
-            break;
-        if (entry->font == font && String::Equals(entry->text, text))
-        {
-            _ttfGetWidthCacheHitCount++;
-            entry->lastUseTick = gCurrentDrawCount;
-            return entry->width;
-        }
-
-        // If entry hasn't been used for a while, replace it
-        if (entry->lastUseTick < gCurrentDrawCount - 64)
-        {
-            break;
-        }
-
-        // Check if next entry is a hit
-        if (++index >= TTF_GETWIDTH_CACHE_SIZE)
-            index = 0;
-    }
-
-    // Cache miss, replace entry with new width
-    entry = &_ttfGetWidthCache[index];
-    TTFGetWidthCacheDispose(entry);
-
-    int32_t width, height;
-    TTFGetSize(font, text, &width, &height);
-
-    _ttfGetWidthCacheMissCount++;
-
-    _ttfGetWidthCacheCount++;
-    entry->width = width;
-    entry->font = font;
-    entry->text = text;
-    entry->lastUseTick = gCurrentDrawCount;
-    return entry->width;
+    auto width = _ttfGetWidthCache.GetOrAdd(
+        font, text, kTTFGetWidthCacheSize, [font, text]() -> std::optional<std::pair<uint32_t, size_t>> {
+            int32_t newWidth, height;
+            TTFGetSize(font, text, &newWidth, &height);
+            return std::make_pair(static_cast<uint32_t>(newWidth), sizeof(uint32_t) + text.size());
+        });
+    return width.value_or(0);
 }
 
 TTFFontDescriptor* TTFGetFontFromSpriteBase(FontStyle fontStyle)
@@ -351,7 +351,7 @@ void X8DrawingEngine::OnDrawDirtyBlock(
 
 void X8DrawingEngine::ConfigureDirtyGrid()
 {
-    _dirtyGrid.BlockShiftX = 7;
+    _dirtyGrid.BlockShiftX = 5; // Match the 32 pixel viewport paint columns
     _dirtyGrid.BlockShiftY = 5; // Keep column at 32 (1 << 5)
     _dirtyGrid.BlockWidth = 1 << _dirtyGrid.BlockShiftX;
     _dirtyGrid.BlockHeight = 1 << _dirtyGrid.BlockShiftY;
@@ -364,24 +364,17 @@ void X8DrawingEngine::ConfigureDirtyGrid()
 
 void X8DrawingEngine::DrawAllDirtyBlocks()
 {
-    // TODO: For optimal performance it is currently limited to a single column.
-    // The optimal approach would be to extract all dirty regions as rectangles not including
-    // parts that are not marked dirty and have the grid more fine grained.
-    // A situation like following:
+    // Dirty blocks are drawn as rectangles that contain no clean blocks. A run of dirty rows in one column is extended
+    // to the right for as long as the neighbouring columns are dirty for all of those rows, e.g.
     //
     //   0 1 2 3 4 5 6 7 8 9
     //   1 - - - - - - - - -
     //   2 - x x x x - - - -
     //   3 - x x - - - - - -
     //   4 - - - - - - - - -
-    //   5 - - - - - - - - -
-    //   6 - - - - - - - - -
-    //   7 - - - - - - - - -
-    //   8 - - - - - - - - -
-    //   9 - - - - - - - - -
     //
-    // Would currently redraw {2,2} to {3,5} where {3,4} and {3,5} are not dirty. Choosing to do this
-    // per column eliminates this issue but limits it to rendering just a single column at a time.
+    // is drawn as the two by two block on the left followed by the rest of the top row. Keeping the columns narrow means a
+    // change only repaints the viewport columns it touches, merging them keeps whole screen redraws to a single draw.
 
     for (uint32_t x = 0; x < _dirtyGrid.BlockColumns; x++)
     {
@@ -393,11 +386,12 @@ void X8DrawingEngine::DrawAllDirtyBlocks()
                 continue;
             }
 
-            // See comment above as to why this is 1.
-            const uint32_t columns = 1;
-
-            // Check rows
-            auto rows = GetNumDirtyRows(x, y, columns);
+            auto rows = GetNumDirtyRows(x, y, 1);
+            uint32_t columns = 1;
+            while (x + columns < _dirtyGrid.BlockColumns && GetNumDirtyRows(x + columns, y, 1) >= rows)
+            {
+                columns++;
+            }
             DrawDirtyBlocks(x, y, columns, rows);
         }
     }
@@ -64,7 +64,7 @@ void EntityBase::Invalidate()
             break;
     }
 
-    ViewportsInvalidate(SpriteData.SpriteRect, maxZoom);
+    ViewportsInvalidateSprite(SpriteData.SpriteRect, maxZoom);
 }
 
 void EntityBase::Serialise(DataSerialiser& stream)
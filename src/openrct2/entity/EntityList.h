@@ -15,16 +15,44 @@
 #include "EntityBase.h"
 #include "EntityRegistry.h"
 
-#include <list>
+#include <algorithm>
 #include <vector>
 
-const std::list<EntityId>& GetEntityList(const EntityType id);
+// Returns the ids of all entities of the given type, sorted by id.
+const std::vector<EntityId>& GetEntityList(const EntityType id);
 
 uint16_t GetEntityListCount(EntityType list);
 uint16_t GetMiscEntityCount();
 uint16_t GetNumFreeEntities();
 const std::vector<EntityId>& GetEntityTileList(const CoordsXY& spritePos);
 
+// Size of a litter index cell in big coordinates.
+constexpr int32_t LITTER_INDEX_CELL_SIZE = 4 * COORDS_XY_STEP;
+
+// Returns the litter within the litter index cell containing the given location, sorted by entity id.
+const std::vector<EntityId>& GetLitterIndexCell(const CoordsXY& loc);
+
+/**
+ * Returns the index to continue iterating a sorted entity list from. nextId is the id that followed the last entity
+ * returned, or null if there was none, and index its position at that time. Entities can be created or removed while a
+ * list is iterated, so as with the linked lists used before, ids created below nextId or after the end was reached are
+ * not visited in this pass, and iteration continues with the first id not below nextId if nextId was removed.
+ */
+inline size_t GetEntityListResumeIndex(const std::vector<EntityId>& list, size_t index, EntityId nextId)
+{
+    if (nextId.IsNull())
+        return list.size();
+    if (index < list.size() && list[index] == nextId)
+        return index;
+    return std::lower_bound(std::begin(list), std::end(list), nextId) - std::begin(list);
+}
+
+// Returns the id at index in an entity list, or null past its end.
+inline EntityId GetEntityListIdAt(const std::vector<EntityId>& list, size_t index)
+{
+    return index < list.size() ? list[index] : EntityId::GetNull();
+}
+
 template<typename T> class EntityTileIterator
 {
 private:
@@ -100,14 +128,16 @@ public:
 template<typename T> class EntityListIterator
 {
 private:
-    std::list<EntityId>::const_iterator iter;
-    std::list<EntityId>::const_iterator end;
+    const std::vector<EntityId>* list;
+    size_t index;
+    EntityId nextId;
     T* Entity = nullptr;
 
 public:
-    EntityListIterator(std::list<EntityId>::const_iterator _iter, std::list<EntityId>::const_iterator _end)
-        : iter(_iter)
-        , end(_end)
+    EntityListIterator(const std::vector<EntityId>& _list, size_t _index)
+        : list(&_list)
+        , index(_index)
+        , nextId(GetEntityListIdAt(_list, _index))
     {
         ++(*this);
     }
@@ -115,10 +145,12 @@ public:
     {
         Entity = nullptr;
 
-        while (iter != end && Entity == nullptr)
+        index = GetEntityListResumeIndex(*list, index, nextId);
+        while (index < list->size() && Entity == nullptr)
         {
-            Entity = GetEntity<T>(*iter++);
+            Entity = GetEntity<T>((*list)[index++]);
         }
+        nextId = GetEntityListIdAt(*list, index);
         return *this;
     }
 
@@ -126,7 +158,7 @@ public:
     {
         EntityListIterator retval = *this;
         ++(*this);
-        return *iter;
+        return retval;
     }
     bool operator==(EntityListIterator other) const
     {
@@ -152,7 +184,7 @@ template<typename T = EntityBase> class EntityList
 {
 private:
     using EntityListIterator_t = EntityListIterator<T>;
-    const std::list<EntityId>& vec;
+    const std::vector<EntityId>& vec;
 
 public:
     EntityList()
@@ -162,10 +194,10 @@ public:
 
     EntityListIterator_t begin() const
     {
-        return EntityListIterator_t(std::cbegin(vec), std::cend(vec));
+        return EntityListIterator_t(vec, 0);
     }
     EntityListIterator_t end() const
     {
-        return EntityListIterator_t(std::cend(vec), std::cend(vec));
+        return EntityListIterator_t(vec, vec.size());
     }
 };
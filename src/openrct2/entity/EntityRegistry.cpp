@@ -25,6 +25,7 @@
 #include "../scenario/Scenario.h"
 #include "Balloon.h"
 #include "Duck.h"
+#include "EntityList.h"
 #include "EntityTweener.h"
 #include "Fountain.h"
 #include "MoneyEffect.h"
@@ -32,6 +33,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iterator>
 #include <numeric>
 #include <vector>
@@ -47,7 +49,8 @@ union Entity
 };
 
 static Entity _entities[MAX_ENTITIES]{};
-static std::array<std::list<EntityId>, EnumValue(EntityType::Count)> gEntityLists;
+// Ids of the entities of each type, kept sorted so iteration follows id order.
+static std::array<std::vector<EntityId>, EnumValue(EntityType::Count)> gEntityLists;
 static std::vector<EntityId> _freeIdList;
 
 static bool _entityFlashingList[MAX_ENTITIES];
@@ -57,6 +60,13 @@ constexpr uint32_t SPATIAL_INDEX_LOCATION_NULL = SPATIAL_INDEX_SIZE - 1;
 
 static std::array<std::vector<EntityId>, SPATIAL_INDEX_SIZE> gEntitySpatialIndex;
 
+constexpr int32_t LITTER_INDEX_COLUMNS = (MAXIMUM_MAP_SIZE_BIG + LITTER_INDEX_CELL_SIZE - 1) / LITTER_INDEX_CELL_SIZE;
+constexpr uint32_t LITTER_INDEX_SIZE = (LITTER_INDEX_COLUMNS * LITTER_INDEX_COLUMNS) + 1;
+constexpr uint32_t LITTER_INDEX_LOCATION_NULL = LITTER_INDEX_SIZE - 1;
+
+// Litter is also kept in a coarse grid so nearby litter can be found without walking every litter entity.
+static std::array<std::vector<EntityId>, LITTER_INDEX_SIZE> _litterIndex;
+
 static void FreeEntity(EntityBase& entity);
 
 static constexpr size_t GetSpatialIndexOffset(const CoordsXY& loc)
@@ -74,6 +84,19 @@ static constexpr size_t GetSpatialIndexOffset(const CoordsXY& loc)
     return tileX * MAXIMUM_MAP_SIZE_TECHNICAL + tileY;
 }
 
+static constexpr size_t GetLitterIndexOffset(const CoordsXY& loc)
+{
+    if (loc.IsNull() || loc.x < 0 || loc.y < 0)
+        return LITTER_INDEX_LOCATION_NULL;
+
+    const auto cellX = loc.x / LITTER_INDEX_CELL_SIZE;
+    const auto cellY = loc.y / LITTER_INDEX_CELL_SIZE;
+    if (cellX >= LITTER_INDEX_COLUMNS || cellY >= LITTER_INDEX_COLUMNS)
+        return LITTER_INDEX_LOCATION_NULL;
+
+    return cellX * LITTER_INDEX_COLUMNS + cellY;
+}
+
 constexpr bool EntityTypeIsMiscEntity(const EntityType type)
 {
     switch (type)
@@ -139,6 +162,11 @@ const std::vector<EntityId>& GetEntityTileList(const CoordsXY& spritePos)
     return gEntitySpatialIndex[GetSpatialIndexOffset(spritePos)];
 }
 
+const std::vector<EntityId>& GetLitterIndexCell(const CoordsXY& loc)
+{
+    return _litterIndex[GetLitterIndexOffset(loc)];
+}
+
 static void ResetEntityLists()
 {
     for (auto& list : gEntityLists)
@@ -160,7 +188,7 @@ static void ResetFreeIds()
     });
 }
 
-const std::list<EntityId>& GetEntityList(const EntityType id)
+const std::vector<EntityId>& GetEntityList(const EntityType id)
 {
     return gEntityLists[EnumValue(id)];
 }
@@ -218,6 +246,10 @@ void ResetEntitySpatialIndices()
     {
         vec.clear();
     }
+    for (auto& vec : _litterIndex)
+    {
+        vec.clear();
+    }
     for (EntityId::UnderlyingType i = 0; i < MAX_ENTITIES; i++)
     {
         auto* spr = GetEntity(EntityId::FromUnderlying(i));
@@ -253,6 +285,75 @@ EntitiesChecksum GetAllEntitiesChecksum()
 
     return checksum;
 }
+
+struct EntityChecksumCacheEntry
+{
+    uint64_t RecordHash;
+    uint64_t Checksum;
+    bool Valid;
+};
+
+// Serialised checksum of each entity, along with a hash of the entity's memory at the time it was computed.
+static std::array<EntityChecksumCacheEntry, MAX_ENTITIES> _entityChecksumCache;
+
+static constexpr uint64_t kEntityHashSeed = 0xcbf29ce484222325ULL;
+static constexpr uint64_t kEntityHashPrime = 0x00000100000001B3ULL;
+
+static void EntityHashCombine(uint64_t& hash, uint64_t value)
+{
+    hash ^= value;
+    hash *= kEntityHashPrime;
+}
+
+// Everything serialised for the checksum is stored inside the entity itself, so the serialised data can only differ
+// when the memory does. This hash is only compared locally and does not need to match between platforms.
+static uint64_t HashEntityRecord(const EntityBase& entity)
+{
+    const auto* record = reinterpret_cast<const uint8_t*>(&entity);
+    uint64_t hash = kEntityHashSeed;
+    for (size_t i = 0; i < sizeof(Entity); i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, record + i, sizeof(word));
+        EntityHashCombine(hash, word);
+    }
+    return hash;
+}
+
+template<typename T> void IncrementalChecksumEntityType(uint64_t& checksum)
+{
+    for (auto* ent : EntityList<T>())
+    {
+        auto& cacheEntry = _entityChecksumCache[ent->Id.ToUnderlying()];
+        const auto recordHash = HashEntityRecord(*ent);
+        if (!cacheEntry.Valid || cacheEntry.RecordHash != recordHash)
+        {
+            std::array<std::byte, 20> raw{};
+            OpenRCT2::ChecksumStream ms(raw);
+            DataSerialiser ds(true, ms);
+            ent->Serialise(ds);
+
+            std::memcpy(&cacheEntry.Checksum, raw.data(), sizeof(cacheEntry.Checksum));
+            cacheEntry.RecordHash = recordHash;
+            cacheEntry.Valid = true;
+        }
+
+        EntityHashCombine(checksum, ent->Id.ToUnderlying());
+        EntityHashCombine(checksum, cacheEntry.Checksum);
+    }
+}
+
+template<typename... T> void IncrementalChecksumEntityTypes(uint64_t& checksum)
+{
+    (IncrementalChecksumEntityType<T>(checksum), ...);
+}
+
+uint64_t GetIncrementalEntitiesChecksum()
+{
+    uint64_t checksum = kEntityHashSeed;
+    IncrementalChecksumEntityTypes<Guest, Staff, Vehicle, Litter>(checksum);
+    return checksum;
+}
 #else
 
 EntitiesChecksum GetAllEntitiesChecksum()
@@ -260,6 +361,11 @@ EntitiesChecksum GetAllEntitiesChecksum()
     return EntitiesChecksum{};
 }
 
+uint64_t GetIncrementalEntitiesChecksum()
+{
+    return 0;
+}
+
 #endif // DISABLE_NETWORK
 
 static void EntityReset(EntityBase* entity)
@@ -418,6 +524,30 @@ void UpdateMoneyEffect()
     MiscUpdateAllTypes<MoneyEffect>();
 }
 
+static void LitterIndexInsert(EntityBase* entity, const CoordsXY& newLoc)
+{
+    size_t newIndex = GetLitterIndexOffset(newLoc);
+    if (newIndex == LITTER_INDEX_LOCATION_NULL)
+        return;
+
+    auto& cell = _litterIndex[newIndex];
+    cell.insert(std::lower_bound(std::begin(cell), std::end(cell), entity->Id), entity->Id);
+}
+
+static void LitterIndexRemove(EntityBase* entity)
+{
+    size_t currentIndex = GetLitterIndexOffset({ entity->x, entity->y });
+    if (currentIndex == LITTER_INDEX_LOCATION_NULL)
+        return;
+
+    auto& cell = _litterIndex[currentIndex];
+    auto index = BinaryFind(std::begin(cell), std::end(cell), entity->Id);
+    if (index != std::end(cell))
+    {
+        cell.erase(index);
+    }
+}
+
 // Performs a search to ensure that insert keeps next_in_quadrant in sprite_index order
 static void EntitySpatialInsert(EntityBase* entity, const CoordsXY& newLoc)
 {
@@ -425,6 +555,11 @@ static void EntitySpatialInsert(EntityBase* entity, const CoordsXY& newLoc)
     auto& spatialVector = gEntitySpatialIndex[newIndex];
     auto index = std::lower_bound(std::begin(spatialVector), std::end(spatialVector), entity->Id);
     spatialVector.insert(index, entity->Id);
+
+    if (entity->Type == EntityType::Litter)
+    {
+        LitterIndexInsert(entity, newLoc);
+    }
 }
 
 static void EntitySpatialRemove(EntityBase* entity)
@@ -435,6 +570,11 @@ static void EntitySpatialRemove(EntityBase* entity)
     if (index != std::end(spatialVector))
     {
         spatialVector.erase(index, index + 1);
+
+        if (entity->Type == EntityType::Litter)
+        {
+            LitterIndexRemove(entity);
+        }
     }
     else
     {
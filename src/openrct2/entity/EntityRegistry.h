@@ -65,5 +65,11 @@ struct EntitiesChecksum
 #pragma pack(pop)
 EntitiesChecksum GetAllEntitiesChecksum();
 
+/**
+ * Checksum of the same entity state as GetAllEntitiesChecksum, cheap enough to compute every tick. Each entity is only
+ * serialised again when its memory has changed since the previous call.
+ */
+uint64_t GetIncrementalEntitiesChecksum();
+
 void EntitySetFlashing(EntityBase* entity, bool flashing);
 bool EntityGetFlashing(EntityBase* entity);
@@ -54,9 +54,11 @@
 #include "../world/Location.hpp"
 #include "../world/Map.h"
 #include "../world/Park.h"
+#include "../world/RidePresence.h"
 #include "../world/Scenery.h"
 #include "../world/Surface.h"
 #include "../world/TileElementsView.h"
+#include "../world/TileSummary.h"
 #include "Peep.h"
 #include "Staff.h"
 
@@ -431,6 +433,10 @@ static bool PeepHasVoucherForFreeRide(Guest* peep, const Ride& ride);
 static void PeepRideIsTooIntense(Guest* peep, Ride& ride, bool peepAtRide);
 static void PeepResetRideHeading(Guest* peep);
 static void PeepTriedToEnterFullQueue(Guest* peep, Ride& ride);
+// Rides that every guest can see, captured before the guests are updated since ratings do not change during that time.
+static OpenRCT2::BitSet<OpenRCT2::Limits::MaxRidesInPark> _tallRides;
+static bool _tallRidesValid;
+
 static int16_t PeepCalculateRideSatisfaction(Guest* peep, const Ride& ride);
 static void PeepUpdateFavouriteRide(Guest* peep, const Ride& ride);
 static int16_t PeepCalculateRideValueSatisfaction(Guest* peep, const Ride& ride);
@@ -1863,6 +1869,30 @@ Ride* Guest::FindBestRideToGoOn()
     return mostExcitingRide;
 }
 
+static OpenRCT2::BitSet<OpenRCT2::Limits::MaxRidesInPark> GetTallRides()
+{
+    OpenRCT2::BitSet<OpenRCT2::Limits::MaxRidesInPark> tallRides;
+    for (auto& ride : GetRideManager())
+    {
+        if (ride.highest_drop_height > 66 || ride.excitement >= RIDE_RATING(8, 00))
+        {
+            tallRides[ride.id.ToUnderlying()] = true;
+        }
+    }
+    return tallRides;
+}
+
+void GuestRefreshTallRides()
+{
+    _tallRides = GetTallRides();
+    _tallRidesValid = true;
+}
+
+void GuestInvalidateTallRides()
+{
+    _tallRidesValid = false;
+}
+
 OpenRCT2::BitSet<OpenRCT2::Limits::MaxRidesInPark> Guest::FindRidesToGoOn()
 {
     OpenRCT2::BitSet<OpenRCT2::Limits::MaxRidesInPark> rideConsideration;
@@ -1887,32 +1917,19 @@ OpenRCT2::BitSet<OpenRCT2::Limits::MaxRidesInPark> Guest::FindRidesToGoOn()
         constexpr auto radius = 10 * 32;
         int32_t cx = Floor2(x, 32);
         int32_t cy = Floor2(y, 32);
-        for (int32_t tileX = cx - radius; tileX <= cx + radius; tileX += COORDS_XY_STEP)
-        {
-            for (int32_t tileY = cy - radius; tileY <= cy + radius; tileY += COORDS_XY_STEP)
-            {
-                auto location = CoordsXY{ tileX, tileY };
-                if (!MapIsLocationValid(location))
-                    continue;
-
-                for (auto* trackElement : TileElementsView<TrackElement>(location))
-                {
-                    auto rideIndex = trackElement->GetRideIndex();
-                    if (!rideIndex.IsNull())
-                    {
-                        rideConsideration[rideIndex.ToUnderlying()] = true;
-                    }
-                }
-            }
-        }
+        // Only tiles of track are visited, tiles outside the map are skipped by the index.
+        auto minTile = TileCoordsXY(CoordsXY{ cx - radius, cy - radius });
+        auto maxTile = TileCoordsXY(CoordsXY{ cx + radius, cy + radius });
+        RidePresenceGetRidesInRange(minTile, maxTile, rideConsideration);
 
         // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
-        for (auto& ride : GetRideManager())
+        if (_tallRidesValid)
         {
-            if (ride.highest_drop_height > 66 || ride.excitement >= RIDE_RATING(8, 00))
-            {
-                rideConsideration[ride.id.ToUnderlying()] = true;
-            }
+            rideConsideration |= _tallRides;
+        }
+        else
+        {
+            rideConsideration |= GetTallRides();
         }
     }
 
@@ -2928,84 +2945,76 @@ static PeepThoughtType PeepAssessSurroundings(int16_t centre_x, int16_t centre_y
     {
         for (int16_t y = initial_y; y < final_y; y += COORDS_XY_STEP)
         {
-            for (auto* tileElement : TileElementsView(CoordsXY{ x, y }))
+            const auto& summary = TileSummaryGet(TileCoordsXY{ CoordsXY{ x, y } });
+            if (summary.Flags & TILE_SUMMARY_FLAG_INVALID_PATH_ADDITION)
             {
-                if (tileElement->IsGhost())
-                {
-                    continue;
-                }
+                return PeepThoughtType::None;
+            }
 
-                switch (tileElement->GetType())
-                {
-                    case TileElementType::Path:
-                    {
-                        if (!tileElement->AsPath()->HasAddition())
-                            break;
+            num_scenery += summary.Scenery;
+            num_fountains += summary.Fountains;
+            num_rubbish += summary.BrokenPaths;
 
-                        auto* pathAddEntry = tileElement->AsPath()->GetAdditionEntry();
-                        if (pathAddEntry == nullptr)
-                        {
-                            return PeepThoughtType::None;
-                        }
-                        if (tileElement->AsPath()->AdditionIsGhost())
-                            break;
+            // Whether a ride is playing music can change at any time so track is still checked per element.
+            if (!(summary.Flags & TILE_SUMMARY_FLAG_HAS_TRACK))
+                continue;
 
-                        if (pathAddEntry->flags
-                            & (PATH_ADDITION_FLAG_JUMPING_FOUNTAIN_WATER | PATH_ADDITION_FLAG_JUMPING_FOUNTAIN_SNOW))
-                        {
-                            num_fountains++;
-                            break;
-                        }
-                        if (tileElement->AsPath()->IsBroken())
-                        {
-                            num_rubbish++;
-                        }
-                        break;
-                    }
-                    case TileElementType::LargeScenery:
-                    case TileElementType::SmallScenery:
-                        num_scenery++;
-                        break;
-                    case TileElementType::Track:
-                    {
-                        auto* ride = GetRide(tileElement->AsTrack()->GetRideIndex());
-                        if (ride == nullptr)
-                            break;
+            for (auto* trackElement : TileElementsView<TrackElement>(CoordsXY{ x, y }))
+            {
+                if (trackElement->IsGhost())
+                {
+                    continue;
+                }
 
-                        bool isPlayingMusic = ride->lifecycle_flags & RIDE_LIFECYCLE_MUSIC && ride->status != RideStatus::Closed
-                            && !(ride->lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED));
-                        if (!isPlayingMusic)
-                            break;
+                auto* ride = GetRide(trackElement->GetRideIndex());
+                if (ride == nullptr)
+                    continue;
 
-                        const auto* musicObject = ride->GetMusicObject();
-                        if (musicObject == nullptr)
-                            break;
+                bool isPlayingMusic = ride->lifecycle_flags & RIDE_LIFECYCLE_MUSIC && ride->status != RideStatus::Closed
+                    && !(ride->lifecycle_flags & (RIDE_LIFECYCLE_BROKEN_DOWN | RIDE_LIFECYCLE_CRASHED));
+                if (!isPlayingMusic)
+                    continue;
 
-                        if (musicObject->GetNiceFactor() == MusicNiceFactor::Nice)
-                        {
-                            nearby_music |= 1;
-                        }
-                        else if (musicObject->GetNiceFactor() == MusicNiceFactor::Overbearing)
-                        {
-                            nearby_music |= 2;
-                        }
+                const auto* musicObject = ride->GetMusicObject();
+                if (musicObject == nullptr)
+                    continue;
 
-                        break;
-                    }
-                    default:
-                        break;
+                if (musicObject->GetNiceFactor() == MusicNiceFactor::Nice)
+                {
+                    nearby_music |= 1;
+                }
+                else if (musicObject->GetNiceFactor() == MusicNiceFactor::Overbearing)
+                {
+                    nearby_music |= 2;
                 }
             }
         }
     }
 
-    for (auto litter : EntityList<Litter>())
+    // Only the litter index cells overlapping the area need to be checked.
+    const auto cellStart = CoordsXY{ std::max(centre_x - 160, 0), std::max(centre_y - 160, 0) };
+    const auto cellEnd = CoordsXY{ std::min(centre_x + 160, MAXIMUM_MAP_SIZE_BIG - 1),
+                                   std::min(centre_y + 160, MAXIMUM_MAP_SIZE_BIG - 1) };
+    auto countNearbyLitter = [&](const std::vector<EntityId>& cell) {
+        for (auto litterId : cell)
+        {
+            auto* litter = GetEntity<Litter>(litterId);
+            if (litter == nullptr)
+                continue;
+
+            int16_t dist_x = abs(litter->x - centre_x);
+            int16_t dist_y = abs(litter->y - centre_y);
+            if (std::max(dist_x, dist_y) <= 160)
+            {
+                num_rubbish++;
+            }
+        }
+    };
+    for (int32_t cellY = cellStart.y / LITTER_INDEX_CELL_SIZE; cellY <= cellEnd.y / LITTER_INDEX_CELL_SIZE; cellY++)
     {
-        int16_t dist_x = abs(litter->x - centre_x);
-        int16_t dist_y = abs(litter->y - centre_y);
-        if (std::max(dist_x, dist_y) <= 160)
+        for (int32_t cellX = cellStart.x / LITTER_INDEX_CELL_SIZE; cellX <= cellEnd.x / LITTER_INDEX_CELL_SIZE; cellX++)
         {
-            num_rubbish++;
+            countNearbyLitter(GetLitterIndexCell({ cellX * LITTER_INDEX_CELL_SIZE, cellY * LITTER_INDEX_CELL_SIZE }));
         }
     }
 
@@ -6248,6 +6257,7 @@ static void PeepUpdateWalkingBreakScenery(Guest* peep)
     }
 
     tileElement->SetIsBroken(true);
+    TileSummaryInvalidateTile(peep->NextLoc);
 
     MapInvalidateTileZoom1({ peep->NextLoc, tileElement->GetBaseZ(), tileElement->GetBaseZ() + 32 });
 
@@ -464,6 +464,9 @@ extern uint8_t gGuestChangeModifier;
 
 void PeepThoughtSetFormatArgs(const PeepThought* thought, Formatter& ft);
 
+void GuestRefreshTallRides();
+void GuestInvalidateTallRides();
+
 void IncrementGuestsInPark();
 void IncrementGuestsHeadingForPark();
 void DecrementGuestsInPark();
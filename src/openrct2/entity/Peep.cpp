@@ -205,6 +205,8 @@ void PeepUpdateAll()
 
     const auto currentTicks = OpenRCT2::GetGameState().CurrentTicks;
 
+    GuestRefreshTallRides();
+
     int32_t i = 0;
     // Warning this loop can delete peeps
     for (auto peep : EntityList<Guest>())
@@ -226,6 +228,8 @@ void PeepUpdateAll()
         i++;
     }
 
+    GuestInvalidateTallRides();
+
     for (auto staff : EntityList<Staff>())
     {
         if (static_cast<uint32_t>(i & 0x7F) != (currentTicks & 0x7F))
@@ -333,14 +333,32 @@ Direction Staff::HandymanDirectionToNearestLitter() const
 {
     uint16_t nearestLitterDist = 0xFFFF;
     Litter* nearestLitter = nullptr;
-    for (auto litter : EntityList<Litter>())
-    {
-        uint16_t distance = abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
 
-        if (distance < nearestLitterDist)
+    // Only litter within MAX_LITTER_DISTANCE on both axes can be close enough, so only the litter index cells
+    // overlapping that area need to be checked. Ties are resolved by the lowest entity id, the same order as
+    // the litter entity list.
+    const auto cellStart = CoordsXY{ std::max(x - MAX_LITTER_DISTANCE, 0), std::max(y - MAX_LITTER_DISTANCE, 0) };
+    const auto cellEnd = CoordsXY{ x + MAX_LITTER_DISTANCE, y + MAX_LITTER_DISTANCE };
+    for (int32_t cellY = cellStart.y / LITTER_INDEX_CELL_SIZE; cellY <= cellEnd.y / LITTER_INDEX_CELL_SIZE; cellY++)
+    {
+        for (int32_t cellX = cellStart.x / LITTER_INDEX_CELL_SIZE; cellX <= cellEnd.x / LITTER_INDEX_CELL_SIZE; cellX++)
         {
-            nearestLitterDist = distance;
-            nearestLitter = litter;
+            const auto cellLoc = CoordsXY{ cellX * LITTER_INDEX_CELL_SIZE, cellY * LITTER_INDEX_CELL_SIZE };
+            for (auto litterId : GetLitterIndexCell(cellLoc))
+            {
+                auto* litter = GetEntity<Litter>(litterId);
+                if (litter == nullptr)
+                    continue;
+
+                uint16_t distance = abs(litter->x - x) + abs(litter->y - y) + abs(litter->z - z) * 4;
+
+                if (distance < nearestLitterDist
+                    || (distance == nearestLitterDist && nearestLitter != nullptr && litter->Id < nearestLitter->Id))
+                {
+                    nearestLitterDist = distance;
+                    nearestLitter = litter;
+                }
+            }
         }
     }
 
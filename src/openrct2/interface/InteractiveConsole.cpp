@@ -79,6 +79,11 @@
 #    include "../drawing/TTF.h"
 #endif
 
+#ifdef ENABLE_SCRIPTING
+#    include "../scripting/HookEngine.h"
+#    include "../scripting/ScriptEngine.h"
+#endif
+
 using namespace OpenRCT2;
 
 using arguments_t = std::vector<std::string>;
@@ -1707,6 +1712,38 @@ static int32_t ConsoleCommandReplayStop(InteractiveConsole& console, const argum
     return 0;
 }
 
+static int32_t ConsoleCommandReplaySeek(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (NetworkGetMode() != NETWORK_MODE_NONE)
+    {
+        console.WriteFormatLine("This command is currently not supported in multiplayer mode.");
+        return 0;
+    }
+
+    if (argv.size() < 1)
+    {
+        console.WriteFormatLine("Parameters required <tick>");
+        return 0;
+    }
+
+    uint32_t replayTick = atol(argv[0].c_str());
+
+    auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
+    if (!replayManager->IsReplaying())
+    {
+        console.WriteFormatLine("Replay currently not playing");
+        return 0;
+    }
+
+    if (replayManager->SeekPlayback(replayTick))
+    {
+        console.WriteFormatLine("Replay moved to tick %u", replayTick);
+        return 1;
+    }
+
+    return 0;
+}
+
 static int32_t ConsoleCommandReplayNormalise(InteractiveConsole& console, const arguments_t& argv)
 {
     if (NetworkGetMode() != NETWORK_MODE_NONE)
@@ -1929,6 +1966,95 @@ static int32_t ConsoleCommandProfilerStop(
     return 0;
 }
 
+static int32_t ConsoleCommandProfilerTraceStart(
+    [[maybe_unused]] InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    if (!OpenRCT2::Profiling::IsTracing())
+        console.WriteLine("Started profiler trace");
+    OpenRCT2::Profiling::StartTrace();
+    return 0;
+}
+
+static int32_t ConsoleCommandProfilerTraceExport(
+    [[maybe_unused]] InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    if (argv.size() < 1)
+    {
+        console.WriteLineError("Missing argument: <file path>");
+        return 1;
+    }
+
+    const auto& traceFilePath = argv[0];
+    if (!OpenRCT2::Profiling::ExportChromeTrace(traceFilePath))
+    {
+        console.WriteFormatLine("Unable to export trace file to %s", traceFilePath.c_str());
+        return 1;
+    }
+
+    console.WriteFormatLine("Wrote trace file: \"%s\"", traceFilePath.c_str());
+    return 0;
+}
+
+static int32_t ConsoleCommandProfilerTraceStop(
+    [[maybe_unused]] InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    if (OpenRCT2::Profiling::IsTracing())
+        console.WriteLine("Stopped profiler trace");
+    OpenRCT2::Profiling::StopTrace();
+
+    // Export the trace if argument is provided.
+    if (argv.size() >= 1)
+    {
+        return ConsoleCommandProfilerTraceExport(console, argv);
+    }
+
+    return 0;
+}
+
+#ifdef ENABLE_SCRIPTING
+static void ConsoleWritePluginCallStats(
+    InteractiveConsole& console, std::string_view name, const OpenRCT2::Scripting::PluginCallStats& stats)
+{
+    console.WriteFormatLine(
+        "  %-24s %8u calls, total %10.2f ms, max %8.2f ms", std::string(name).c_str(), stats.CallCount,
+        stats.TotalTimeUs / 1000.0, stats.MaxTimeUs / 1000.0);
+}
+
+static int32_t ConsoleCommandPluginTimings(InteractiveConsole& console, const arguments_t& argv)
+{
+    using namespace OpenRCT2::Scripting;
+
+    auto& scriptEngine = GetContext()->GetScriptEngine();
+    if (argv.size() >= 1 && argv[0] == "reset")
+    {
+        scriptEngine.ResetPluginTimings();
+        console.WriteLine("Reset plugin timings");
+        return 0;
+    }
+
+    for (const auto& plugin : scriptEngine.GetPlugins())
+    {
+        const auto& timings = plugin->GetTimings();
+        console.WriteFormatLine(
+            "%s: %u budget overruns, %u deferred intervals", plugin->GetMetadata().Name.c_str(), timings.OverrunCount,
+            timings.DeferredCount);
+        ConsoleWritePluginCallStats(console, "total", timings.Total);
+        if (timings.Intervals.CallCount != 0)
+        {
+            ConsoleWritePluginCallStats(console, "intervals", timings.Intervals);
+        }
+        for (size_t i = 0; i < NUM_HOOK_TYPES; i++)
+        {
+            if (timings.Hooks[i].CallCount != 0)
+            {
+                ConsoleWritePluginCallStats(console, GetHookTypeName(static_cast<HOOK_TYPE>(i)), timings.Hooks[i]);
+            }
+        }
+    }
+    return 0;
+}
+#endif
+
 static int32_t ConsoleSpawnBalloon(InteractiveConsole& console, const arguments_t& argv)
 {
     if (argv.size() < 3)
@@ -2049,6 +2175,7 @@ static constexpr ConsoleCommand console_command_table[] = {
     { "replay_stoprecord", ConsoleCommandReplayStopRecord, "Stops recording a new replay.", "replay_stoprecord" },
     { "replay_start", ConsoleCommandReplayStart, "Starts a replay", "replay_start <name>" },
     { "replay_stop", ConsoleCommandReplayStop, "Stops the replay", "replay_stop" },
+    { "replay_seek", ConsoleCommandReplaySeek, "Moves the replay to the given tick", "replay_seek <tick>" },
     { "replay_normalise", ConsoleCommandReplayNormalise, "Normalises the replay to remove all gaps",
       "replay_normalise <input file> <output file>" },
     { "mp_desync", ConsoleCommandMpDesync, "Forces a multiplayer desync",
@@ -2058,6 +2185,16 @@ static constexpr ConsoleCommand console_command_table[] = {
     { "profiler_stop", ConsoleCommandProfilerStop, "Stops the profiler.", "profiler_stop [<output file>]" },
     { "profiler_exportcsv", ConsoleCommandProfilerExportCSV, "Exports the current profiler data.",
       "profiler_exportcsv <output file>" },
+    { "profiler_trace_start", ConsoleCommandProfilerTraceStart, "Starts recording a trace of the profiled functions.",
+      "profiler_trace_start" },
+    { "profiler_trace_stop", ConsoleCommandProfilerTraceStop, "Stops recording the profiler trace.",
+      "profiler_trace_stop [<output file>]" },
+    { "profiler_trace_export", ConsoleCommandProfilerTraceExport, "Exports the profiler trace as Chrome trace JSON.",
+      "profiler_trace_export <output file>" },
+#ifdef ENABLE_SCRIPTING
+    { "plugin_timings", ConsoleCommandPluginTimings, "Shows the time spent in each plugin and hook.",
+      "plugin_timings [reset]" },
+#endif
 };
 
 static int32_t ConsoleCommandWindows(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
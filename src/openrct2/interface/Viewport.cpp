@@ -44,6 +44,7 @@
 #include <algorithm>
 #include <cstring>
 #include <list>
+#include <tuple>
 #include <unordered_map>
 
 using namespace OpenRCT2;
@@ -242,6 +243,158 @@ void ViewportsInvalidate(const ScreenRect& screenRect, ZoomLevel maxZoom)
     }
 }
 
+struct DirtyTile
+{
+    CoordsXY Pos;
+    int32_t BaseZ;
+    int32_t ClearanceZ;
+    ZoomLevel MaxZoom;
+};
+
+struct DirtySprite
+{
+    ScreenRect Rect;
+    ZoomLevel MaxZoom;
+};
+
+// Pending invalidations beyond which they are flushed straight away, e.g. when nothing is drawn while minimised.
+static constexpr size_t kMaxPendingInvalidations = 65536;
+
+static std::vector<DirtyTile> _dirtyTiles;
+static std::unordered_map<uint32_t, size_t> _dirtyTileIndices;
+static std::vector<DirtySprite> _dirtySprites;
+
+// ZoomLevel{ -1 } invalidates all viewports regardless of their zoom.
+static ZoomLevel CombineMaxZoom(ZoomLevel a, ZoomLevel b)
+{
+    if (a == ZoomLevel{ -1 } || b == ZoomLevel{ -1 })
+        return ZoomLevel{ -1 };
+    return std::max(a, b);
+}
+
+static bool RectEquals(const ScreenRect& a, const ScreenRect& b)
+{
+    return a.Point1 == b.Point1 && a.Point2 == b.Point2;
+}
+
+static ScreenRect GetTileInvalidationRect(const DirtyTile& tile, int32_t rotation)
+{
+    auto screenCoord = Translate3DTo2DWithZ(rotation, { tile.Pos.x + 16, tile.Pos.y + 16, 0 });
+    return { { screenCoord.x - 32, screenCoord.y - 32 - tile.ClearanceZ },
+             { screenCoord.x + 32, screenCoord.y + 32 - tile.BaseZ } };
+}
+
+void ViewportsInvalidateTile(const CoordsXYRangedZ& tilePos, ZoomLevel maxZoom)
+{
+    if (_viewports.empty())
+        return;
+
+    const auto tileStart = tilePos.ToTileStart();
+    const auto key = (static_cast<uint32_t>(static_cast<uint16_t>(tileStart.x / COORDS_XY_STEP)) << 16)
+        | static_cast<uint16_t>(tileStart.y / COORDS_XY_STEP);
+    auto [it, inserted] = _dirtyTileIndices.try_emplace(key, _dirtyTiles.size());
+    if (!inserted)
+    {
+        auto& tile = _dirtyTiles[it->second];
+        tile.BaseZ = std::min(tile.BaseZ, tilePos.baseZ);
+        tile.ClearanceZ = std::max(tile.ClearanceZ, tilePos.clearanceZ);
+        tile.MaxZoom = CombineMaxZoom(tile.MaxZoom, maxZoom);
+        return;
+    }
+
+    _dirtyTiles.push_back({ tileStart, tilePos.baseZ, tilePos.clearanceZ, maxZoom });
+    if (_dirtyTiles.size() + _dirtySprites.size() >= kMaxPendingInvalidations)
+        ViewportsFlushInvalidations();
+}
+
+void ViewportsInvalidateSprite(const ScreenRect& spriteRect, ZoomLevel maxZoom)
+{
+    if (_viewports.empty())
+        return;
+
+    // Entities are commonly invalidated several times in a row without moving, skip the obvious repeats here and the
+    // rest when flushing.
+    if (!_dirtySprites.empty())
+    {
+        auto& last = _dirtySprites.back();
+        if (RectEquals(last.Rect, spriteRect))
+        {
+            last.MaxZoom = CombineMaxZoom(last.MaxZoom, maxZoom);
+            return;
+        }
+    }
+
+    _dirtySprites.push_back({ spriteRect, maxZoom });
+    if (_dirtyTiles.size() + _dirtySprites.size() >= kMaxPendingInvalidations)
+        ViewportsFlushInvalidations();
+}
+
+void ViewportsFlushInvalidations()
+{
+    PROFILED_FUNCTION();
+
+    const auto rotation = GetCurrentRotation();
+    for (const auto& tile : _dirtyTiles)
+    {
+        ViewportsInvalidate(GetTileInvalidationRect(tile, rotation), tile.MaxZoom);
+    }
+    _dirtyTiles.clear();
+    _dirtyTileIndices.clear();
+
+    auto toTuple = [](const DirtySprite& sprite) {
+        return std::make_tuple(
+            sprite.Rect.GetLeft(), sprite.Rect.GetTop(), sprite.Rect.GetRight(), sprite.Rect.GetBottom(),
+            static_cast<int8_t>(sprite.MaxZoom));
+    };
+    std::sort(_dirtySprites.begin(), _dirtySprites.end(), [&toTuple](const DirtySprite& a, const DirtySprite& b) {
+        return toTuple(a) < toTuple(b);
+    });
+    for (size_t i = 0; i < _dirtySprites.size();)
+    {
+        const auto& rect = _dirtySprites[i].Rect;
+        auto maxZoom = _dirtySprites[i].MaxZoom;
+        for (i++; i < _dirtySprites.size() && RectEquals(_dirtySprites[i].Rect, rect); i++)
+        {
+            maxZoom = CombineMaxZoom(maxZoom, _dirtySprites[i].MaxZoom);
+        }
+        ViewportsInvalidate(rect, maxZoom);
+    }
+    _dirtySprites.clear();
+}
+
+bool ViewportsIsMapAreaVisible(const CoordsXY& mins, const CoordsXY& maxs, int32_t maxZ)
+{
+    if (_viewports.empty())
+        return false;
+
+    const auto rotation = GetCurrentRotation();
+    const CoordsXY corners[] = { mins, { maxs.x, mins.y }, { mins.x, maxs.y }, maxs };
+    ScreenCoordsXY topLeft = Translate3DTo2DWithZ(rotation, { mins, 0 });
+    ScreenCoordsXY bottomRight = topLeft;
+    for (const auto& corner : corners)
+    {
+        const auto screenCoord = Translate3DTo2DWithZ(rotation, { corner, 0 });
+        topLeft = { std::min(topLeft.x, screenCoord.x), std::min(topLeft.y, screenCoord.y - maxZ) };
+        bottomRight = { std::max(bottomRight.x, screenCoord.x), std::max(bottomRight.y, screenCoord.y) };
+    }
+
+    // Allow for images that extend past their tile
+    topLeft -= { 32, 32 };
+    bottomRight += { 32, 32 };
+    for (const auto& vp : _viewports)
+    {
+        if (vp.visibility == VisibilityCache::Covered)
+            continue;
+
+        if (bottomRight.x > vp.viewPos.x && bottomRight.y > vp.viewPos.y && topLeft.x < vp.viewPos.x + vp.view_width
+            && topLeft.y < vp.viewPos.y + vp.view_height)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  *
  *  rct2: 0x00689174
@@ -977,38 +1130,33 @@ void ViewportPaint(const Viewport* viewport, DrawPixelInfo& dpi, const ScreenRec
             dpi2.pitch += dpi2.zoom_level.ApplyInversedTo(rightPitch);
         }
         dpi2.width = paintRight - dpi2.x;
+    }
 
-        if (useMultithreading)
-        {
-            _paintJobs->AddTask([session]() -> void { ViewportFillColumn(*session); });
-        }
-        else
+    // Fill columns.
+    if (useMultithreading)
+    {
+        _paintJobs->ParallelFor(_paintColumns.size(), [](size_t i) { ViewportFillColumn(*_paintColumns[i]); });
+    }
+    else
+    {
+        for (auto* session : _paintColumns)
         {
             ViewportFillColumn(*session);
         }
     }
 
-    if (useMultithreading)
+    // Paint columns.
+    if (useParallelDrawing)
     {
-        _paintJobs->Join();
+        _paintJobs->ParallelFor(_paintColumns.size(), [](size_t i) { ViewportPaintColumn(*_paintColumns[i]); });
     }
-
-    // Paint columns.
-    for (auto* session : _paintColumns)
+    else
     {
-        if (useParallelDrawing)
-        {
-            _paintJobs->AddTask([session]() -> void { ViewportPaintColumn(*session); });
-        }
-        else
+        for (auto* session : _paintColumns)
         {
             ViewportPaintColumn(*session);
         }
     }
-    if (useParallelDrawing)
-    {
-        _paintJobs->Join();
-    }
 
     // Release resources.
     for (auto* session : _paintColumns)
@@ -1882,7 +2030,8 @@ void ViewportInvalidate(const Viewport* viewport, const ScreenRect& screenRect)
     const auto [viewportRight, viewportBottom] = viewport->viewPos
         + ScreenCoordsXY{ viewport->view_width, viewport->view_height };
 
-    if (bottomRight.x > viewport->viewPos.x && bottomRight.y > viewport->viewPos.y)
+    if (bottomRight.x > viewport->viewPos.x && bottomRight.y > viewport->viewPos.y && topLeft.x < viewportRight
+        && topLeft.y < viewportBottom)
     {
         topLeft = { std::max(topLeft.x, viewport->viewPos.x), std::max(topLeft.y, viewport->viewPos.y) };
         topLeft -= viewport->viewPos;
@@ -133,6 +133,21 @@ std::optional<ScreenCoordsXY> centre_2d_coordinates(const CoordsXYZ& loc, Viewpo
 void ViewportCreate(WindowBase* w, const ScreenCoordsXY& screenCoords, int32_t width, int32_t height, const Focus& focus);
 void ViewportRemove(Viewport* viewport);
 void ViewportsInvalidate(const ScreenRect& screenRect, ZoomLevel maxZoom = ZoomLevel{ -1 });
+
+/**
+ * Deferred invalidation of a tile or an entity sprite. Changes made during a tick are collected, deduplicated per tile
+ * and projected into the viewports once per frame by ViewportsFlushInvalidations, skipping viewports they are not
+ * visible in.
+ */
+void ViewportsInvalidateTile(const CoordsXYRangedZ& tilePos, ZoomLevel maxZoom);
+void ViewportsInvalidateSprite(const ScreenRect& spriteRect, ZoomLevel maxZoom);
+void ViewportsFlushInvalidations();
+
+/**
+ * Returns whether any part of the map area between mins and maxs, up to the given height, can be seen in a viewport
+ * that is not covered by other windows.
+ */
+bool ViewportsIsMapAreaVisible(const CoordsXY& mins, const CoordsXY& maxs, int32_t maxZ);
 void ViewportUpdatePosition(WindowBase* window);
 void ViewportUpdateFollowSprite(WindowBase* window);
 void ViewportUpdateSmartFollowEntity(WindowBase* window);
@@ -46,7 +46,7 @@ using namespace OpenRCT2;
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
 
-#define NETWORK_STREAM_VERSION "0"
+#define NETWORK_STREAM_VERSION "1"
 
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
@@ -207,6 +207,7 @@ void NetworkBase::Close()
         _serverTickData.clear();
         _pendingPlayerLists.clear();
         _pendingPlayerInfo.clear();
+        InvalidateMapSnapshot();
 
 #    ifdef ENABLE_SCRIPTING
         auto& scriptEngine = GetContext().GetScriptEngine();
@@ -242,6 +243,7 @@ void NetworkBase::CloseConnection()
     }
     else if (mode == NETWORK_MODE_SERVER)
     {
+        _receiveThread.reset();
         _listenSocket.reset();
         _advertiser.reset();
     }
@@ -376,6 +378,16 @@ bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
         return false;
     }
 
+    try
+    {
+        _receiveThread = std::make_unique<NetworkReceiveThread>();
+    }
+    catch (const std::exception& ex)
+    {
+        // Connections are then read on the game thread.
+        LOG_WARNING("Unable to start network receive thread: %s", ex.what());
+    }
+
     ServerName = gConfigNetwork.ServerName;
     ServerDescription = gConfigNetwork.ServerDescription;
     ServerGreeting = gConfigNetwork.ServerGreeting;
@@ -728,6 +740,12 @@ const char* NetworkBase::FormatChat(NetworkPlayer* fromplayer, const char* text)
 }
 
 void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, bool gameCmd) const
+{
+    // Encoded once, every connection queues the same buffer.
+    SendPacketToClients(packet.Encode(), front, gameCmd);
+}
+
+void NetworkBase::SendPacketToClients(const NetworkPacketBufferPtr& buffer, bool front, bool gameCmd) const
 {
     for (auto& client_connection : client_connection_list)
     {
@@ -742,7 +760,7 @@ void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, b
                 continue;
             }
         }
-        client_connection->QueuePacket(packet, front);
+        client_connection->QueuePacket(buffer, front);
     }
 }
 
@@ -765,6 +783,19 @@ bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
         return false;
     }
 
+    if (storedTick.entitiesChecksum.has_value())
+    {
+        const auto clientChecksum = GetIncrementalEntitiesChecksum();
+        if (clientChecksum != *storedTick.entitiesChecksum)
+        {
+            LOG_INFO(
+                "Entities checksum mismatch, client = %016llx, server = %016llx",
+                static_cast<long long unsigned>(clientChecksum),
+                static_cast<long long unsigned>(*storedTick.entitiesChecksum));
+            return false;
+        }
+    }
+
     if (!storedTick.spriteHash.empty())
     {
         EntitiesChecksum checksum = GetAllEntitiesChecksum();
@@ -1195,7 +1226,7 @@ void NetworkBase::Client_Send_RequestGameState(uint32_t tick)
 
     NetworkPacket packet(NetworkCommand::RequestGameState);
     packet << tick;
-    _serverConnection->QueuePacket(std::move(packet));
+    _serverConnection->QueuePacket(packet);
 }
 
 void NetworkBase::Client_Send_TOKEN()
@@ -1203,7 +1234,7 @@ void NetworkBase::Client_Send_TOKEN()
     LOG_VERBOSE("requesting token");
     NetworkPacket packet(NetworkCommand::Token);
     _serverConnection->AuthStatus = NetworkAuth::Requested;
-    _serverConnection->QueuePacket(std::move(packet));
+    _serverConnection->QueuePacket(packet);
 }
 
 void NetworkBase::Client_Send_AUTH(
@@ -1218,7 +1249,7 @@ void NetworkBase::Client_Send_AUTH(
     packet << static_cast<uint32_t>(signature.size());
     packet.Write(signature.data(), signature.size());
     _serverConnection->AuthStatus = NetworkAuth::Requested;
-    _serverConnection->QueuePacket(std::move(packet));
+    _serverConnection->QueuePacket(packet);
 }
 
 void NetworkBase::Client_Send_MAPREQUEST(const std::vector<ObjectEntryDescriptor>& objects)
@@ -1241,7 +1272,21 @@ void NetworkBase::Client_Send_MAPREQUEST(const std::vector<ObjectEntryDescriptor
             packet.WriteString(name);
         }
     }
-    _serverConnection->QueuePacket(std::move(packet));
+
+    // Ask to continue an interrupted download from the same server, the server starts over if the map has changed since.
+    uint32_t resumeSnapshotId = 0;
+    uint32_t resumeOffset = 0;
+    auto& download = _clientMapDownload;
+    if (download.Host == _host && download.Port == _port && download.Received > 0 && download.Received < download.Size)
+    {
+        LOG_VERBOSE("client resumes map download at %u of %u bytes", download.Received, download.Size);
+        resumeSnapshotId = download.SnapshotId;
+        resumeOffset = download.Received;
+    }
+    packet << resumeSnapshotId << resumeOffset;
+    download.Active = false;
+
+    _serverConnection->QueuePacket(packet);
 }
 
 void NetworkBase::ServerSendToken(NetworkConnection& connection)
@@ -1249,7 +1294,7 @@ void NetworkBase::ServerSendToken(NetworkConnection& connection)
     NetworkPacket packet(NetworkCommand::Token);
     packet << static_cast<uint32_t>(connection.Challenge.size());
     packet.Write(connection.Challenge.data(), connection.Challenge.size());
-    connection.QueuePacket(std::move(packet));
+    connection.QueuePacket(packet);
 }
 
 void NetworkBase::ServerSendObjectsList(
@@ -1262,7 +1307,7 @@ void NetworkBase::ServerSendObjectsList(
         NetworkPacket packet(NetworkCommand::ObjectsList);
         packet << static_cast<uint32_t>(0) << static_cast<uint32_t>(objects.size());
 
-        connection.QueuePacket(std::move(packet));
+        connection.QueuePacket(packet);
     }
     else
     {
@@ -1288,7 +1333,7 @@ void NetworkBase::ServerSendObjectsList(
                 packet.WriteString(object->Identifier);
             }
 
-            connection.QueuePacket(std::move(packet));
+            connection.QueuePacket(packet);
         }
     }
 }
@@ -1319,7 +1364,7 @@ void NetworkBase::ServerSendScripts(NetworkConnection& connection)
     NetworkPacket packetScriptHeader(NetworkCommand::ScriptsHeader);
     packetScriptHeader << static_cast<uint32_t>(remotePlugins.size());
     packetScriptHeader << static_cast<uint32_t>(pluginData.GetLength());
-    connection.QueuePacket(std::move(packetScriptHeader));
+    connection.QueuePacket(packetScriptHeader);
 
     // Segment the plugin data into chunks and send them.
     const uint8_t* pluginDataBuffer = static_cast<const uint8_t*>(pluginData.GetData());
@@ -1332,7 +1377,7 @@ void NetworkBase::ServerSendScripts(NetworkConnection& connection)
         packet << chunkSize;
         packet.Write(pluginDataBuffer + dataOffset, chunkSize);
 
-        connection.QueuePacket(std::move(packet));
+        connection.QueuePacket(packet);
 
         dataOffset += chunkSize;
     }
@@ -1350,7 +1395,7 @@ void NetworkBase::Client_Send_HEARTBEAT(NetworkConnection& connection) const
     LOG_VERBOSE("Sending heartbeat");
 
     NetworkPacket packet(NetworkCommand::Heartbeat);
-    connection.QueuePacket(std::move(packet));
+    connection.QueuePacket(packet);
 }
 
 NetworkStats NetworkBase::GetStats() const
@@ -1387,14 +1432,14 @@ void NetworkBase::ServerSendAuth(NetworkConnection& connection)
     {
         packet.WriteString(NetworkGetVersion());
     }
-    connection.QueuePacket(std::move(packet));
+    connection.QueuePacket(packet);
     if (connection.AuthStatus != NetworkAuth::Ok && connection.AuthStatus != NetworkAuth::RequirePassword)
     {
         connection.Disconnect();
     }
 }
 
-void NetworkBase::ServerSendMap(NetworkConnection* connection)
+void NetworkBase::ServerSendMap(NetworkConnection* connection, uint32_t resumeSnapshotId, uint32_t resumeOffset)
 {
     std::vector<const ObjectRepositoryItem*> objects;
     if (connection != nullptr)
@@ -1410,8 +1455,8 @@ void NetworkBase::ServerSendMap(NetworkConnection* connection)
         objects = objManager.GetPackableObjects();
     }
 
-    auto header = SaveForNetwork(objects);
-    if (header.empty())
+    // Sending to everyone happens after loading a new map, which the tick alone does not tell apart.
+    if (!UpdateMapSnapshot(objects, connection == nullptr))
     {
         if (connection != nullptr)
         {
@@ -1420,45 +1465,91 @@ void NetworkBase::ServerSendMap(NetworkConnection* connection)
         }
         return;
     }
-    size_t chunksize = CHUNK_SIZE;
-    for (size_t i = 0; i < header.size(); i += chunksize)
+
+    const auto& snapshot = _serverMapSnapshot;
+    if (connection == nullptr)
     {
-        size_t datasize = std::min(chunksize, header.size() - i);
-        NetworkPacket packet(NetworkCommand::Map);
-        packet << static_cast<uint32_t>(header.size()) << static_cast<uint32_t>(i);
-        packet.Write(&header[i], datasize);
-        if (connection != nullptr)
+        for (const auto& chunk : snapshot.Chunks)
         {
-            connection->QueuePacket(std::move(packet));
-        }
-        else
-        {
-            SendPacketToClients(packet);
+            SendPacketToClients(chunk);
         }
+        return;
+    }
+
+    size_t firstChunk = 0;
+    if (resumeSnapshotId == snapshot.Id && resumeOffset < snapshot.Size)
+    {
+        firstChunk = resumeOffset / CHUNK_SIZE;
+        LOG_VERBOSE(
+            "Client resumes map download at %u of %u bytes", static_cast<uint32_t>(firstChunk * CHUNK_SIZE), snapshot.Size);
+    }
+    for (size_t i = firstChunk; i < snapshot.Chunks.size(); i++)
+    {
+        connection->QueuePacket(snapshot.Chunks[i]);
     }
 }
 
-std::vector<uint8_t> NetworkBase::SaveForNetwork(const std::vector<const ObjectRepositoryItem*>& objects) const
+bool NetworkBase::UpdateMapSnapshot(const std::vector<const ObjectRepositoryItem*>& objects, bool forceNew)
 {
-    std::vector<uint8_t> result;
-    auto ms = OpenRCT2::MemoryStream();
-    if (SaveMap(&ms, objects))
+    auto& snapshot = _serverMapSnapshot;
+    const auto currentTick = GetGameState().CurrentTicks;
+    if (!forceNew && !snapshot.Chunks.empty() && snapshot.Tick == currentTick && snapshot.Objects == objects)
     {
-        result.resize(ms.GetLength());
-        std::memcpy(result.data(), ms.GetData(), result.size());
+        return true;
     }
-    else
+
+    InvalidateMapSnapshot();
+    auto header = SaveForNetwork(objects);
+    if (header.GetLength() == 0)
+    {
+        return false;
+    }
+
+    // Never zero, which clients use for not resuming.
+    uint32_t id;
+    do
+    {
+        id = UtilRand();
+    } while (id == 0);
+
+    snapshot.Id = id;
+    snapshot.Tick = currentTick;
+    snapshot.Size = static_cast<uint32_t>(header.GetLength());
+    snapshot.Objects = objects;
+
+    const auto* headerData = static_cast<const uint8_t*>(header.GetData());
+    for (uint32_t i = 0; i < snapshot.Size; i += CHUNK_SIZE)
+    {
+        const uint32_t datasize = std::min(CHUNK_SIZE, snapshot.Size - i);
+        NetworkPacket packet(NetworkCommand::Map);
+        packet << snapshot.Size << i << snapshot.Id;
+        packet.Write(headerData + i, datasize);
+        snapshot.Chunks.push_back(packet.Encode());
+    }
+    return true;
+}
+
+void NetworkBase::InvalidateMapSnapshot()
+{
+    _serverMapSnapshot = {};
+}
+
+OpenRCT2::MemoryStream NetworkBase::SaveForNetwork(const std::vector<const ObjectRepositoryItem*>& objects) const
+{
+    auto ms = OpenRCT2::MemoryStream();
+    if (!SaveMap(&ms, objects))
     {
         LOG_WARNING("Failed to export map.");
+        return OpenRCT2::MemoryStream();
     }
-    return result;
+    return ms;
 }
 
 void NetworkBase::Client_Send_CHAT(const char* text)
 {
     NetworkPacket packet(NetworkCommand::Chat);
     packet.WriteString(text);
-    _serverConnection->QueuePacket(std::move(packet));
+    _serverConnection->QueuePacket(packet);
 }
 
 void NetworkBase::ServerSendChat(const char* text, const std::vector<uint8_t>& playerIds)
@@ -1473,12 +1564,13 @@ void NetworkBase::ServerSendChat(const char* text, const std::vector<uint8_t>& p
     }
     else
     {
+        const auto buffer = packet.Encode();
         for (auto playerId : playerIds)
         {
             auto conn = GetPlayerConnection(playerId);
             if (conn != nullptr)
             {
-                conn->QueuePacket(packet);
+                conn->QueuePacket(buffer);
             }
         }
     }
@@ -1502,7 +1594,7 @@ void NetworkBase::Client_Send_GAME_ACTION(const GameAction* action)
     action->Serialise(stream);
 
     packet << GetGameState().CurrentTicks << action->GetType() << stream;
-    _serverConnection->QueuePacket(std::move(packet));
+    _serverConnection->QueuePacket(packet);
 }
 
 void NetworkBase::ServerSendGameAction(const GameAction* action)
@@ -1514,6 +1606,9 @@ void NetworkBase::ServerSendGameAction(const GameAction* action)
 
     packet << GetGameState().CurrentTicks << action->GetType() << stream;
 
+    // The action changed the game state without advancing the tick.
+    InvalidateMapSnapshot();
+
     SendPacketToClients(packet);
 }
 
@@ -1521,7 +1616,8 @@ void NetworkBase::ServerSendTick()
 {
     NetworkPacket packet(NetworkCommand::Tick);
     packet << GetGameState().CurrentTicks << ScenarioRandState().s0;
-    uint32_t flags = 0;
+    // The incremental checksum is cheap enough to send every tick.
+    uint32_t flags = NETWORK_TICK_FLAG_INCREMENTAL_CHECKSUM;
     // Simple counter which limits how often a sprite checksum gets sent.
     // This can get somewhat expensive, so we don't want to push it every tick in release,
     // but debug version can check more often.
@@ -1540,6 +1636,10 @@ void NetworkBase::ServerSendTick()
         EntitiesChecksum checksum = GetAllEntitiesChecksum();
         packet.WriteString(checksum.ToString());
     }
+    if (flags & NETWORK_TICK_FLAG_INCREMENTAL_CHECKSUM)
+    {
+        packet << GetIncrementalEntitiesChecksum();
+    }
 
     SendPacketToClients(packet);
 }
@@ -1571,7 +1671,7 @@ void NetworkBase::ServerSendPlayerList()
 void NetworkBase::Client_Send_PING()
 {
     NetworkPacket packet(NetworkCommand::Ping);
-    _serverConnection->QueuePacket(std::move(packet));
+    _serverConnection->QueuePacket(packet);
 }
 
 void NetworkBase::ServerSendPing()
@@ -1600,7 +1700,7 @@ void NetworkBase::ServerSendSetDisconnectMsg(NetworkConnection& connection, cons
 {
     NetworkPacket packet(NetworkCommand::DisconnectMessage);
     packet.WriteString(msg);
-    connection.QueuePacket(std::move(packet));
+    connection.QueuePacket(packet);
 }
 
 json_t NetworkBase::GetServerInfoAsJson() const
@@ -1638,14 +1738,14 @@ void NetworkBase::ServerSendGameInfo(NetworkConnection& connection)
     packet << IsServerPlayerInvisible;
 
 #    endif
-    connection.QueuePacket(std::move(packet));
+    connection.QueuePacket(packet);
 }
 
 void NetworkBase::ServerSendShowError(NetworkConnection& connection, StringId title, StringId message)
 {
     NetworkPacket packet(NetworkCommand::ShowError);
     packet << title << message;
-    connection.QueuePacket(std::move(packet));
+    connection.QueuePacket(packet);
 }
 
 void NetworkBase::ServerSendGroupList(NetworkConnection& connection)
@@ -1656,7 +1756,7 @@ void NetworkBase::ServerSendGroupList(NetworkConnection& connection)
     {
         group->Write(packet);
     }
-    connection.QueuePacket(std::move(packet));
+    connection.QueuePacket(packet);
 }
 
 void NetworkBase::ServerSendEventPlayerJoined(const char* playerName)
@@ -1678,38 +1778,42 @@ void NetworkBase::ServerSendEventPlayerDisconnected(const char* playerName, cons
 
 bool NetworkBase::ProcessConnection(NetworkConnection& connection)
 {
-    NetworkReadPacket packetStatus;
+    // Server connections are read on the receive thread, anything else is read here.
+    if (_receiveThread == nullptr)
+    {
+        connection.ReceivePackets();
+    }
+
+    // The receive thread queues the last packets before it marks the connection as closed, so the flag has to be read
+    // before draining the queue or those packets could be dropped.
+    const bool receiveClosed = connection.ReceiveClosed;
 
+    NetworkPacket packet;
     uint32_t countProcessed = 0;
-    do
+    while (countProcessed < MaxPacketsPerUpdate && connection.PopReceivedPacket(packet))
     {
         countProcessed++;
-        packetStatus = connection.ReadPacket();
-        switch (packetStatus)
+        ProcessPacket(connection, packet);
+        if (!connection.IsValid())
         {
-            case NetworkReadPacket::Disconnected:
-                // closed connection or network error
-                if (!connection.GetLastDisconnectReason())
-                {
-                    connection.SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
-                }
-                return false;
-            case NetworkReadPacket::Success:
-                // done reading in packet
-                ProcessPacket(connection, connection.InboundPacket);
-                if (!connection.IsValid())
-                {
-                    return false;
-                }
-                break;
-            case NetworkReadPacket::MoreData:
-                // more data required to be read
-                break;
-            case NetworkReadPacket::NoData:
-                // could not read anything from socket
-                break;
+            return false;
+        }
+    }
+
+    if (_receiveThread != nullptr && connection.ReceivePaused)
+    {
+        _receiveThread->Resume(connection);
+    }
+
+    if (receiveClosed && countProcessed < MaxPacketsPerUpdate)
+    {
+        // closed connection or network error, all packets received before have been processed
+        if (!connection.GetLastDisconnectReason())
+        {
+            connection.SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
         }
-    } while (packetStatus == NetworkReadPacket::Success && countProcessed < MaxPacketsPerUpdate);
+        return false;
+    }
 
     if (!connection.ReceivedPacketRecently())
     {
@@ -1958,6 +2062,11 @@ void NetworkBase::ProcessDisconnectedClients()
             continue;
         }
 
+        if (_receiveThread != nullptr)
+        {
+            _receiveThread->Remove(*connection);
+        }
+
         // Make sure to send all remaining packets out before disconnecting.
         connection->SendQueuedPackets();
         connection->Socket->Disconnect();
@@ -1979,6 +2088,10 @@ void NetworkBase::AddClient(std::unique_ptr<ITcpSocket>&& socket)
     // Store connection
     auto connection = std::make_unique<NetworkConnection>();
     connection->Socket = std::move(socket);
+    if (_receiveThread != nullptr)
+    {
+        _receiveThread->Add(*connection);
+    }
 
     client_connection_list.push_back(std::move(connection));
 }
@@ -2229,7 +2342,7 @@ void NetworkBase::ServerHandleRequestGamestate(NetworkConnection& connection, Ne
             packetGameStateChunk << tick << length << bytesSent << dataSize;
             packetGameStateChunk.Write(static_cast<const uint8_t*>(snapshotMemory.GetData()) + bytesSent, dataSize);
 
-            connection.QueuePacket(std::move(packetGameStateChunk));
+            connection.QueuePacket(packetGameStateChunk);
 
             bytesSent += dataSize;
         }
@@ -2567,8 +2680,12 @@ void NetworkBase::ServerHandleMapRequest(NetworkConnection& connection, NetworkP
         }
     }
 
+    uint32_t resumeSnapshotId;
+    uint32_t resumeOffset;
+    packet >> resumeSnapshotId >> resumeOffset;
+
     auto player_name = connection.Player->Name.c_str();
-    ServerSendMap(&connection);
+    ServerSendMap(&connection, resumeSnapshotId, resumeOffset);
     ServerSendEventPlayerJoined(player_name);
     ServerSendGroupList(connection);
 }
@@ -2705,14 +2822,16 @@ void NetworkBase::ServerHandleAuth(NetworkConnection& connection, NetworkPacket&
 
 void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
 {
-    uint32_t size, offset;
-    packet >> size >> offset;
+    uint32_t size, offset, snapshotId;
+    packet >> size >> offset >> snapshotId;
     int32_t chunksize = static_cast<int32_t>(packet.Header.Size - packet.BytesRead);
     if (chunksize <= 0)
     {
         return;
     }
-    if (offset == 0)
+
+    auto& download = _clientMapDownload;
+    if (!download.Active || offset == 0)
     {
         // Start of a new map load, clear the queue now as we have to buffer them
         // until the map is fully loaded.
@@ -2721,6 +2840,21 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
 
         _serverTickData.clear();
         _clientMapLoaded = false;
+        download.Active = true;
+    }
+    if (offset == 0)
+    {
+        download.Host = _host;
+        download.Port = _port;
+        download.SnapshotId = snapshotId;
+        download.Size = size;
+        download.Received = 0;
+    }
+    if (snapshotId != download.SnapshotId || size != download.Size || offset != download.Received
+        || offset + chunksize > size)
+    {
+        LOG_WARNING("Received map chunk at %u that does not continue the current download.", offset);
+        return;
     }
     if (size > chunk_buffer.size())
     {
@@ -2739,8 +2873,11 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
     ContextOpenIntent(&intent);
 
     std::memcpy(&chunk_buffer[offset], const_cast<void*>(static_cast<const void*>(packet.Read(chunksize))), chunksize);
-    if (offset + chunksize == size)
+    download.Received += chunksize;
+    if (download.Received == size)
     {
+        download = {};
+
         // Allow queue processing of game actions again.
         GameActions::ResumeQueue();
 
@@ -3038,6 +3175,12 @@ void NetworkBase::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connect
             tickData.spriteHash = text;
         }
     }
+    if (flags & NETWORK_TICK_FLAG_INCREMENTAL_CHECKSUM)
+    {
+        uint64_t entitiesChecksum;
+        packet >> entitiesChecksum;
+        tickData.entitiesChecksum = entitiesChecksum;
+    }
 
     // Don't let the history grow too much.
     while (_serverTickData.size() >= 100)
@@ -3186,7 +3329,7 @@ void NetworkBase::Client_Send_GAMEINFO()
 {
     LOG_VERBOSE("requesting gameinfo");
     NetworkPacket packet(NetworkCommand::GameInfo);
-    _serverConnection->QueuePacket(std::move(packet));
+    _serverConnection->QueuePacket(packet);
 }
 
 void NetworkBase::Client_Handle_GAMEINFO([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
@@ -2,16 +2,19 @@
 
 #include "../System.hpp"
 #include "../actions/GameAction.h"
+#include "../core/MemoryStream.h"
 #include "../object/Object.h"
 #include "NetworkConnection.h"
 #include "NetworkGroup.h"
 #include "NetworkPlayer.h"
+#include "NetworkReceiveThread.h"
 #include "NetworkServerAdvertiser.h"
 #include "NetworkTypes.h"
 #include "NetworkUser.h"
 
 #include <fstream>
 #include <memory>
+#include <optional>
 
 #ifndef DISABLE_NETWORK
 
@@ -79,13 +82,15 @@ public: // Server
     void UpdateServer();
     void ServerClientDisconnected(std::unique_ptr<NetworkConnection>& connection);
     bool SaveMap(OpenRCT2::IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const;
-    std::vector<uint8_t> SaveForNetwork(const std::vector<const ObjectRepositoryItem*>& objects) const;
+    OpenRCT2::MemoryStream SaveForNetwork(const std::vector<const ObjectRepositoryItem*>& objects) const;
+    bool UpdateMapSnapshot(const std::vector<const ObjectRepositoryItem*>& objects, bool forceNew);
+    void InvalidateMapSnapshot();
     std::string MakePlayerNameUnique(const std::string& name);
 
     // Packet dispatchers.
     void ServerSendAuth(NetworkConnection& connection);
     void ServerSendToken(NetworkConnection& connection);
-    void ServerSendMap(NetworkConnection* connection = nullptr);
+    void ServerSendMap(NetworkConnection* connection = nullptr, uint32_t resumeSnapshotId = 0, uint32_t resumeOffset = 0);
     void ServerSendChat(const char* text, const std::vector<uint8_t>& playerIds = {});
     void ServerSendGameAction(const GameAction* action);
     void ServerSendTick();
@@ -124,6 +129,7 @@ public: // Client
     void ProcessDisconnectedClients();
     static const char* FormatChat(NetworkPlayer* fromplayer, const char* text);
     void SendPacketToClients(const NetworkPacket& packet, bool front = false, bool gameCmd = false) const;
+    void SendPacketToClients(const NetworkPacketBufferPtr& buffer, bool front = false, bool gameCmd = false) const;
     bool CheckSRAND(uint32_t tick, uint32_t srand0);
     bool CheckDesynchronizaton();
     void RequestStateSnapshot();
@@ -199,12 +205,25 @@ private: // Server Data
     std::unique_ptr<ITcpSocket> _listenSocket;
     std::unique_ptr<INetworkServerAdvertiser> _advertiser;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
+    // Declared after the connections so it stops before they are destroyed.
+    std::unique_ptr<NetworkReceiveThread> _receiveThread;
     std::string _serverLogPath;
     std::string _serverLogFilenameFormat = "%Y%m%d-%H%M%S.txt";
     std::ofstream _server_log_fs;
     uint16_t listening_port = 0;
     bool _playerListInvalidated = false;
 
+    // The encoded map sent to joining clients, reused until the game state changes.
+    struct ServerMapSnapshot
+    {
+        uint32_t Id{};
+        uint32_t Tick{};
+        uint32_t Size{};
+        std::vector<const ObjectRepositoryItem*> Objects;
+        std::vector<NetworkPacketBufferPtr> Chunks;
+    };
+    ServerMapSnapshot _serverMapSnapshot;
+
 private: // Client Data
     struct PlayerListUpdate
     {
@@ -216,6 +235,18 @@ private: // Client Data
         uint32_t srand0;
         uint32_t tick;
         std::string spriteHash;
+        std::optional<uint64_t> entitiesChecksum;
+    };
+
+    // Progress of the map download, kept after disconnecting so a reconnect can resume it.
+    struct ClientMapDownload
+    {
+        std::string Host;
+        uint16_t Port{};
+        uint32_t SnapshotId{};
+        uint32_t Size{};
+        uint32_t Received{};
+        bool Active{};
     };
 
     struct ServerScriptsData
@@ -248,6 +279,7 @@ private: // Client Data
     bool _requireReconnect = false;
     bool _clientMapLoaded = false;
     ServerScriptsData _serverScriptsData{};
+    ClientMapDownload _clientMapDownload;
 };
 
 #endif // DISABLE_NETWORK
@@ -20,6 +20,7 @@
 
 constexpr size_t NETWORK_DISCONNECT_REASON_BUFFER_SIZE = 256;
 constexpr size_t NetworkBufferSize = 1024 * 64; // 64 KiB, maximum packet size.
+constexpr size_t NetworkMaxReceivedPackets = 256; // Received packets queued before reading pauses.
 
 NetworkConnection::NetworkConnection() noexcept
 {
@@ -85,9 +86,6 @@ NetworkReadPacket NetworkConnection::ReadPacket()
         {
             // Received complete packet.
             _lastPacketTime = Platform::GetTicks();
-
-            RecordPacketStats(InboundPacket, false);
-
             return NetworkReadPacket::Success;
         }
     }
@@ -95,42 +93,64 @@ NetworkReadPacket NetworkConnection::ReadPacket()
     return NetworkReadPacket::MoreData;
 }
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
+void NetworkConnection::ReceivePackets()
 {
-    auto header = packet.Header;
+    while (!IsReceiveQueueFull())
+    {
+        NetworkReadPacket status;
+        try
+        {
+            status = ReadPacket();
+        }
+        catch (const std::exception&)
+        {
+            // The socket was closed by another thread.
+            status = NetworkReadPacket::Disconnected;
+        }
 
-    std::vector<uint8_t> buffer;
-    buffer.reserve(sizeof(header) + header.Size);
+        if (status == NetworkReadPacket::Success)
+        {
+            _receivedPackets.Push(std::move(InboundPacket));
+            InboundPacket = NetworkPacket();
+        }
+        else if (status == NetworkReadPacket::Disconnected)
+        {
+            ReceiveClosed = true;
+            break;
+        }
+        else if (status == NetworkReadPacket::NoData)
+        {
+            break;
+        }
+    }
+}
 
-    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
-    // Previously the Id field was not part of the header rather part of the body.
-    header.Size += sizeof(header.Id);
-    header.Size = Convert::HostToNetwork(header.Size);
-    header.Id = ByteSwapBE(header.Id);
+bool NetworkConnection::PopReceivedPacket(NetworkPacket& packet)
+{
+    if (!_receivedPackets.TryPop(packet))
+        return false;
 
-    buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
-    buffer.insert(buffer.end(), packet.Data.begin(), packet.Data.end());
+    RecordPacketStats(packet.GetCommand(), packet.BytesTransferred, false);
+    return true;
+}
 
-    size_t bufferSize = buffer.size() - packet.BytesTransferred;
-    size_t sent = Socket->SendData(buffer.data() + packet.BytesTransferred, bufferSize);
-    if (sent > 0)
-    {
-        packet.BytesTransferred += sent;
-    }
+bool NetworkConnection::IsReceiveQueueFull() const
+{
+    return _receivedPackets.GetSize() >= NetworkMaxReceivedPackets;
+}
 
-    bool sendComplete = packet.BytesTransferred == buffer.size();
-    if (sendComplete)
+void NetworkConnection::QueuePacket(const NetworkPacket& packet, bool front)
+{
+    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
     {
-        RecordPacketStats(packet, true);
+        QueuePacket(packet.Encode(), front);
     }
-    return sendComplete;
 }
 
-void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
+void NetworkConnection::QueuePacket(const NetworkPacketBufferPtr& buffer, bool front)
 {
-    if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
+    if (AuthStatus == NetworkAuth::Ok || !NetworkCommandRequiresAuth(buffer->Command))
     {
-        packet.Header.Size = static_cast<uint16_t>(packet.Data.size());
         if (front)
         {
             // If the first packet was already partially sent add new packet to second position
@@ -138,16 +158,16 @@ void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
             {
                 auto it = _outboundPackets.begin();
                 it++; // Second position
-                _outboundPackets.insert(it, std::move(packet));
+                _outboundPackets.insert(it, { buffer });
             }
             else
             {
-                _outboundPackets.push_front(std::move(packet));
+                _outboundPackets.push_front({ buffer });
             }
         }
         else
         {
-            _outboundPackets.push_back(std::move(packet));
+            _outboundPackets.push_back({ buffer });
         }
     }
 }
@@ -164,9 +184,42 @@ bool NetworkConnection::IsValid() const
 
 void NetworkConnection::SendQueuedPackets()
 {
-    while (!_outboundPackets.empty() && SendPacket(_outboundPackets.front()))
+    SocketBuffer buffers[SocketMaxSendBuffers];
+    while (!_outboundPackets.empty())
     {
-        _outboundPackets.pop_front();
+        // Gather the remainder of as many queued packets as possible into a single send.
+        size_t count = 0;
+        size_t totalSize = 0;
+        for (auto it = _outboundPackets.begin(); it != _outboundPackets.end() && count < SocketMaxSendBuffers; it++)
+        {
+            const auto& data = it->Buffer->Data;
+            buffers[count] = { data.data() + it->BytesTransferred, data.size() - it->BytesTransferred };
+            totalSize += buffers[count].Size;
+            count++;
+        }
+
+        const size_t sent = Socket->SendBuffers(buffers, count);
+        size_t unaccounted = sent;
+        while (unaccounted > 0)
+        {
+            auto& packet = _outboundPackets.front();
+            const auto remaining = packet.Buffer->Data.size() - packet.BytesTransferred;
+            if (unaccounted < remaining)
+            {
+                packet.BytesTransferred += unaccounted;
+                break;
+            }
+
+            unaccounted -= remaining;
+            RecordPacketStats(packet.Buffer->Command, packet.Buffer->Data.size(), true);
+            _outboundPackets.pop_front();
+        }
+
+        if (sent < totalSize)
+        {
+            // Socket would block, try again later.
+            break;
+        }
     }
 }
 
@@ -203,12 +256,12 @@ void NetworkConnection::SetLastDisconnectReason(const StringId string_id, void*
     SetLastDisconnectReason(buffer);
 }
 
-void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool sending)
+void NetworkConnection::RecordPacketStats(NetworkCommand command, size_t size, bool sending)
 {
-    uint32_t packetSize = static_cast<uint32_t>(packet.BytesTransferred);
+    uint32_t packetSize = static_cast<uint32_t>(size);
     NetworkStatisticsGroup trafficGroup;
 
-    switch (packet.GetCommand())
+    switch (command)
     {
         case NetworkCommand::GameAction:
             trafficGroup = NetworkStatisticsGroup::Commands;
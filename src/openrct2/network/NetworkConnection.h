@@ -11,11 +11,13 @@
 
 #ifndef DISABLE_NETWORK
 #    include "../common.h"
+#    include "../core/SpscQueue.hpp"
 #    include "NetworkKey.h"
 #    include "NetworkPacket.h"
 #    include "NetworkTypes.h"
 #    include "Socket.h"
 
+#    include <atomic>
 #    include <deque>
 #    include <memory>
 #    include <string_view>
@@ -38,15 +40,20 @@ public:
     std::vector<const ObjectRepositoryItem*> RequestedObjects;
     bool ShouldDisconnect = false;
 
+    // Receiving state, shared with the network thread when the connection is read there.
+    std::atomic<bool> ReceiveClosed = false;
+    std::atomic<bool> ReceivePaused = false;
+    uint64_t ReceiveKey = 0;
+
     NetworkConnection() noexcept;
 
-    NetworkReadPacket ReadPacket();
-    void QueuePacket(NetworkPacket&& packet, bool front = false);
-    void QueuePacket(const NetworkPacket& packet, bool front = false)
-    {
-        auto copy = packet;
-        return QueuePacket(std::move(copy), front);
-    }
+    // Reads and frames packets from the socket until it has no more data or the received queue is full.
+    // Sets ReceiveClosed once the socket is closed. Only one thread may receive on a connection.
+    void ReceivePackets();
+    bool PopReceivedPacket(NetworkPacket& packet);
+    bool IsReceiveQueueFull() const;
+    void QueuePacket(const NetworkPacket& packet, bool front = false);
+    void QueuePacket(const NetworkPacketBufferPtr& buffer, bool front = false);
 
     // This will not immediately disconnect the client. The disconnect
     // will happen post-tick.
@@ -62,12 +69,19 @@ public:
     void SetLastDisconnectReason(const StringId string_id, void* args = nullptr);
 
 private:
-    std::deque<NetworkPacket> _outboundPackets;
-    uint32_t _lastPacketTime = 0;
+    struct OutboundPacket
+    {
+        NetworkPacketBufferPtr Buffer;
+        size_t BytesTransferred = 0;
+    };
+
+    std::deque<OutboundPacket> _outboundPackets;
+    OpenRCT2::SpscQueue<NetworkPacket> _receivedPackets;
+    std::atomic<uint32_t> _lastPacketTime = 0;
     std::string _lastDisconnectReason;
 
-    void RecordPacketStats(const NetworkPacket& packet, bool sending);
-    bool SendPacket(NetworkPacket& packet);
+    NetworkReadPacket ReadPacket();
+    void RecordPacketStats(NetworkCommand command, size_t size, bool sending);
 };
 
 #endif // DISABLE_NETWORK
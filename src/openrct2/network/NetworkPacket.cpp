@@ -12,8 +12,85 @@
 #    include "NetworkPacket.h"
 
 #    include "NetworkTypes.h"
+#    include "Socket.h"
 
 #    include <memory>
+#    include <mutex>
+
+// Maximum number of released buffers kept for reuse.
+static constexpr size_t kMaxPooledBuffers = 256;
+
+// Buffers that grew beyond this are freed instead of pooled, the largest packets are sent rarely.
+static constexpr size_t kMaxPooledBufferCapacity = sizeof(PacketHeader) + 0x10000;
+
+class NetworkPacketBufferPool final : public std::enable_shared_from_this<NetworkPacketBufferPool>
+{
+private:
+    std::mutex _mutex;
+    std::vector<std::unique_ptr<NetworkPacketBuffer>> _free;
+
+public:
+    std::shared_ptr<NetworkPacketBuffer> Acquire()
+    {
+        std::unique_ptr<NetworkPacketBuffer> buffer;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_free.empty())
+            {
+                buffer = std::move(_free.back());
+                _free.pop_back();
+            }
+        }
+        if (buffer == nullptr)
+        {
+            buffer = std::make_unique<NetworkPacketBuffer>();
+        }
+
+        // The deleter holds on to the pool so buffers can safely outlive any other reference to it.
+        return std::shared_ptr<NetworkPacketBuffer>(
+            buffer.release(), [pool = shared_from_this()](NetworkPacketBuffer* released) { pool->Release(released); });
+    }
+
+private:
+    void Release(NetworkPacketBuffer* released)
+    {
+        std::unique_ptr<NetworkPacketBuffer> buffer(released);
+        if (buffer->Data.capacity() > kMaxPooledBufferCapacity)
+            return;
+
+        buffer->Data.clear();
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_free.size() < kMaxPooledBuffers)
+        {
+            _free.push_back(std::move(buffer));
+        }
+    }
+};
+
+static NetworkPacketBufferPool& GetPacketBufferPool()
+{
+    static auto pool = std::make_shared<NetworkPacketBufferPool>();
+    return *pool;
+}
+
+bool NetworkCommandRequiresAuth(NetworkCommand command) noexcept
+{
+    switch (command)
+    {
+        case NetworkCommand::Ping:
+        case NetworkCommand::Auth:
+        case NetworkCommand::Token:
+        case NetworkCommand::GameInfo:
+        case NetworkCommand::ObjectsList:
+        case NetworkCommand::ScriptsHeader:
+        case NetworkCommand::ScriptsData:
+        case NetworkCommand::MapRequest:
+        case NetworkCommand::Heartbeat:
+            return false;
+        default:
+            return true;
+    }
+}
 
 NetworkPacket::NetworkPacket(NetworkCommand id) noexcept
     : Header{ 0, id }
@@ -44,21 +121,7 @@ void NetworkPacket::Clear() noexcept
 
 bool NetworkPacket::CommandRequiresAuth() const noexcept
 {
-    switch (GetCommand())
-    {
-        case NetworkCommand::Ping:
-        case NetworkCommand::Auth:
-        case NetworkCommand::Token:
-        case NetworkCommand::GameInfo:
-        case NetworkCommand::ObjectsList:
-        case NetworkCommand::ScriptsHeader:
-        case NetworkCommand::ScriptsData:
-        case NetworkCommand::MapRequest:
-        case NetworkCommand::Heartbeat:
-            return false;
-        default:
-            return true;
-    }
+    return NetworkCommandRequiresAuth(GetCommand());
 }
 
 void NetworkPacket::Write(const void* bytes, size_t size)
@@ -73,6 +136,24 @@ void NetworkPacket::WriteString(std::string_view s)
     Data.push_back(0);
 }
 
+NetworkPacketBufferPtr NetworkPacket::Encode() const
+{
+    PacketHeader header;
+    header.Id = ByteSwapBE(Header.Id);
+
+    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
+    // Previously the Id field was not part of the header rather part of the body.
+    header.Size = Convert::HostToNetwork(static_cast<uint16_t>(Data.size() + sizeof(header.Id)));
+
+    auto buffer = GetPacketBufferPool().Acquire();
+    buffer->Command = Header.Id;
+    buffer->Data.reserve(sizeof(header) + Data.size());
+    const auto* headerBytes = reinterpret_cast<const uint8_t*>(&header);
+    buffer->Data.insert(buffer->Data.end(), headerBytes, headerBytes + sizeof(header));
+    buffer->Data.insert(buffer->Data.end(), Data.begin(), Data.end());
+    return buffer;
+}
+
 const uint8_t* NetworkPacket::Read(size_t size)
 {
     if (BytesRead + size > Data.size())
@@ -25,6 +25,20 @@ struct PacketHeader
 static_assert(sizeof(PacketHeader) == 6);
 #pragma pack(pop)
 
+/**
+ * A packet encoded for sending, the wire header followed by the body. Buffers are reference counted so a packet sent
+ * to several connections is encoded once and shared between their send queues. Released buffers are returned to a
+ * pool and reused for the next packet.
+ */
+struct NetworkPacketBuffer final
+{
+    NetworkCommand Command = NetworkCommand::Invalid;
+    std::vector<uint8_t> Data;
+};
+using NetworkPacketBufferPtr = std::shared_ptr<const NetworkPacketBuffer>;
+
+bool NetworkCommandRequiresAuth(NetworkCommand command) noexcept;
+
 struct NetworkPacket final
 {
     NetworkPacket() noexcept = default;
@@ -44,6 +58,9 @@ struct NetworkPacket final
     void Write(const void* bytes, size_t size);
     void WriteString(std::string_view s);
 
+    // Encodes the header and body into a pooled buffer ready to be queued on any number of connections.
+    NetworkPacketBufferPtr Encode() const;
+
     template<typename T> NetworkPacket& operator>>(T& value)
     {
         if (BytesRead + sizeof(value) > Header.Size)
@@ -0,0 +1,105 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkReceiveThread.h"
+
+#    include "../Diagnostic.h"
+#    include "NetworkConnection.h"
+
+#    include <vector>
+
+// Upper bound on how long the thread sleeps, in case a platform can not wake it up.
+static constexpr int32_t kWaitTimeout = 100;
+
+NetworkReceiveThread::NetworkReceiveThread()
+    : _poller(CreateSocketPoller())
+{
+    _thread = std::thread(&NetworkReceiveThread::Run, this);
+}
+
+NetworkReceiveThread::~NetworkReceiveThread()
+{
+    _shouldStop = true;
+    _poller->Wake();
+    _thread.join();
+}
+
+void NetworkReceiveThread::Add(NetworkConnection& connection)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    connection.ReceiveKey = _nextKey++;
+    _connections[connection.ReceiveKey] = &connection;
+    try
+    {
+        _poller->Add(*connection.Socket, connection.ReceiveKey);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("%s", e.what());
+        connection.ReceiveClosed = true;
+    }
+}
+
+void NetworkReceiveThread::Remove(NetworkConnection& connection)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_connections.erase(connection.ReceiveKey) != 0 && !connection.ReceivePaused && !connection.ReceiveClosed)
+    {
+        _poller->Remove(*connection.Socket);
+    }
+}
+
+void NetworkReceiveThread::Resume(NetworkConnection& connection)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!connection.ReceivePaused || connection.ReceiveClosed || connection.IsReceiveQueueFull())
+            return;
+
+        connection.ReceivePaused = false;
+        _poller->Add(*connection.Socket, connection.ReceiveKey);
+    }
+    _poller->Wake();
+}
+
+void NetworkReceiveThread::Run()
+{
+    std::vector<uint64_t> readyKeys;
+    while (!_shouldStop)
+    {
+        readyKeys.clear();
+        _poller->Wait(kWaitTimeout, readyKeys);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto key : readyKeys)
+        {
+            // Keys are never reused, a removed connection can not be mistaken for a new one.
+            auto it = _connections.find(key);
+            if (it == _connections.end())
+                continue;
+
+            auto& connection = *it->second;
+            connection.ReceivePackets();
+            if (connection.ReceiveClosed)
+            {
+                _poller->Remove(*connection.Socket);
+            }
+            else if (connection.IsReceiveQueueFull())
+            {
+                // Stop watching the socket until the game thread has caught up, it would be reported readable forever.
+                _poller->Remove(*connection.Socket);
+                connection.ReceivePaused = true;
+            }
+        }
+    }
+}
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,55 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+
+#    include "Socket.h"
+
+#    include <atomic>
+#    include <cstdint>
+#    include <memory>
+#    include <mutex>
+#    include <thread>
+#    include <unordered_map>
+
+class NetworkConnection;
+
+/**
+ * Reads and frames the packets of server connections on a separate thread. The thread sleeps until a socket becomes
+ * readable and queues complete packets on their connection, the game thread only processes the queued packets.
+ */
+class NetworkReceiveThread final
+{
+private:
+    std::unique_ptr<ISocketPoller> _poller;
+    std::thread _thread;
+    std::atomic<bool> _shouldStop = false;
+
+    // Held while reading so connections are never removed in the middle of being read.
+    std::mutex _mutex;
+    std::unordered_map<uint64_t, NetworkConnection*> _connections;
+    uint64_t _nextKey = 0;
+
+public:
+    NetworkReceiveThread();
+    ~NetworkReceiveThread();
+
+    void Add(NetworkConnection& connection);
+    // The thread no longer accesses the connection once this returns.
+    void Remove(NetworkConnection& connection);
+    // Continues reading a connection that was paused because its received queue was full.
+    void Resume(NetworkConnection& connection);
+
+private:
+    void Run();
+};
+
+#endif // DISABLE_NETWORK
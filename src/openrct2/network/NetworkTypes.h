@@ -23,6 +23,7 @@ enum
 enum
 {
     NETWORK_TICK_FLAG_CHECKSUMS = 1 << 0,
+    NETWORK_TICK_FLAG_INCREMENTAL_CHECKSUM = 1 << 1,
 };
 
 enum
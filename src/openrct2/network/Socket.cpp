@@ -9,11 +9,15 @@
 
 #ifndef DISABLE_NETWORK
 
+#    include <algorithm>
+#    include <array>
 #    include <atomic>
 #    include <chrono>
 #    include <cmath>
 #    include <cstring>
 #    include <future>
+#    include <limits>
+#    include <mutex>
 #    include <string>
 #    include <thread>
 
@@ -41,6 +45,7 @@
         #define SHUT_RDWR SD_BOTH
     #endif
     #define FLAG_NO_PIPE 0
+    #define poll WSAPoll
 #else
     #include <arpa/inet.h>
     #include <cerrno>
@@ -50,8 +55,10 @@
     #include <netinet/in.h>
     #include <netinet/tcp.h>
     #include <unistd.h>
+    #include <poll.h>
     #include <sys/ioctl.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include <unistd.h>
     #include "../common.h"
     using SOCKET = int32_t;
@@ -61,6 +68,8 @@
     #define closesocket close
     #define ioctlsocket ioctl
     #if defined(__linux__)
+        #include <sys/epoll.h>
+        #include <sys/eventfd.h>
         #define FLAG_NO_PIPE MSG_NOSIGNAL
     #else
         #define FLAG_NO_PIPE 0
@@ -571,6 +580,50 @@ public:
         return totalSent;
     }
 
+    size_t SendBuffers(const SocketBuffer* buffers, size_t count) override
+    {
+        if (_status != SocketStatus::Connected)
+        {
+            throw std::runtime_error("Socket not connected.");
+        }
+        if (count == 0)
+        {
+            return 0;
+        }
+        count = std::min(count, SocketMaxSendBuffers);
+
+#    ifdef _WIN32
+        std::array<WSABUF, SocketMaxSendBuffers> wsaBuffers;
+        for (size_t i = 0; i < count; i++)
+        {
+            wsaBuffers[i].buf = static_cast<CHAR*>(const_cast<void*>(buffers[i].Data));
+            wsaBuffers[i].len = static_cast<ULONG>(buffers[i].Size);
+        }
+        DWORD sentBytes = 0;
+        if (WSASend(_socket, wsaBuffers.data(), static_cast<DWORD>(count), &sentBytes, 0, nullptr, nullptr) == SOCKET_ERROR)
+        {
+            return 0;
+        }
+        return sentBytes;
+#    else
+        std::array<iovec, SocketMaxSendBuffers> iov;
+        for (size_t i = 0; i < count; i++)
+        {
+            iov[i].iov_base = const_cast<void*>(buffers[i].Data);
+            iov[i].iov_len = buffers[i].Size;
+        }
+        msghdr message{};
+        message.msg_iov = iov.data();
+        message.msg_iovlen = count;
+        auto sentBytes = sendmsg(_socket, &message, FLAG_NO_PIPE);
+        if (sentBytes == SOCKET_ERROR)
+        {
+            return 0;
+        }
+        return static_cast<size_t>(sentBytes);
+#    endif
+    }
+
     NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) override
     {
         if (_status != SocketStatus::Connected)
@@ -631,6 +684,11 @@ public:
         return _ipAddress;
     }
 
+    SOCKET GetSocket() const noexcept
+    {
+        return _socket;
+    }
+
 private:
     void CloseSocket()
     {
@@ -861,6 +919,238 @@ private:
     }
 };
 
+static SOCKET GetPollableSocket(ITcpSocket& socket)
+{
+    auto* tcpSocket = dynamic_cast<TcpSocket*>(&socket);
+    if (tcpSocket == nullptr)
+    {
+        throw std::invalid_argument("socket is not compatible.");
+    }
+    return tcpSocket->GetSocket();
+}
+
+#    if defined(__linux__)
+class EpollSocketPoller final : public ISocketPoller
+{
+private:
+    static constexpr uint64_t kWakeKey = std::numeric_limits<uint64_t>::max();
+    static constexpr int32_t kMaxEvents = 64;
+
+    int32_t _epoll = -1;
+    int32_t _wakeEvent = -1;
+
+public:
+    EpollSocketPoller()
+    {
+        _epoll = epoll_create1(EPOLL_CLOEXEC);
+        _wakeEvent = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (_epoll == -1 || _wakeEvent == -1)
+        {
+            Close();
+            throw SocketException("Unable to create socket poller.");
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = kWakeKey;
+        epoll_ctl(_epoll, EPOLL_CTL_ADD, _wakeEvent, &event);
+    }
+
+    ~EpollSocketPoller() override
+    {
+        Close();
+    }
+
+    void Add(ITcpSocket& socket, uint64_t key) override
+    {
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = key;
+        if (epoll_ctl(_epoll, EPOLL_CTL_ADD, GetPollableSocket(socket), &event) != 0)
+        {
+            throw SocketException("Unable to watch socket: " + std::to_string(LAST_SOCKET_ERROR()));
+        }
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        epoll_event event{};
+        epoll_ctl(_epoll, EPOLL_CTL_DEL, GetPollableSocket(socket), &event);
+    }
+
+    void Wait(int32_t timeout, std::vector<uint64_t>& readyKeys) override
+    {
+        epoll_event events[kMaxEvents];
+        const auto count = epoll_wait(_epoll, events, kMaxEvents, timeout);
+        for (int32_t i = 0; i < count; i++)
+        {
+            if (events[i].data.u64 == kWakeKey)
+            {
+                uint64_t value;
+                [[maybe_unused]] auto result = read(_wakeEvent, &value, sizeof(value));
+            }
+            else
+            {
+                readyKeys.push_back(events[i].data.u64);
+            }
+        }
+    }
+
+    void Wake() override
+    {
+        const uint64_t value = 1;
+        [[maybe_unused]] auto result = write(_wakeEvent, &value, sizeof(value));
+    }
+
+private:
+    void Close()
+    {
+        if (_wakeEvent != -1)
+        {
+            close(_wakeEvent);
+            _wakeEvent = -1;
+        }
+        if (_epoll != -1)
+        {
+            close(_epoll);
+            _epoll = -1;
+        }
+    }
+};
+#    endif
+
+/**
+ * Fallback for platforms without epoll. The set of sockets is copied for each wait.
+ */
+class PollSocketPoller final : public ISocketPoller
+{
+private:
+    struct Entry
+    {
+        SOCKET Socket;
+        uint64_t Key;
+    };
+
+    std::mutex _mutex;
+    std::vector<Entry> _entries;
+    std::vector<pollfd> _fds;
+    std::vector<uint64_t> _keys;
+#    ifndef _WIN32
+    int32_t _wakePipe[2] = { -1, -1 };
+#    endif
+
+public:
+    PollSocketPoller()
+    {
+#    ifndef _WIN32
+        if (pipe(_wakePipe) != 0)
+        {
+            throw SocketException("Unable to create socket poller.");
+        }
+        fcntl(_wakePipe[0], F_SETFL, O_NONBLOCK);
+        fcntl(_wakePipe[1], F_SETFL, O_NONBLOCK);
+#    endif
+    }
+
+    ~PollSocketPoller() override
+    {
+#    ifndef _WIN32
+        close(_wakePipe[0]);
+        close(_wakePipe[1]);
+#    endif
+    }
+
+    void Add(ITcpSocket& socket, uint64_t key) override
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.push_back({ GetPollableSocket(socket), key });
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        const auto handle = GetPollableSocket(socket);
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.erase(
+            std::remove_if(_entries.begin(), _entries.end(), [handle](const Entry& e) { return e.Socket == handle; }),
+            _entries.end());
+    }
+
+    void Wait(int32_t timeout, std::vector<uint64_t>& readyKeys) override
+    {
+        _fds.clear();
+        _keys.clear();
+#    ifndef _WIN32
+        _fds.push_back({ _wakePipe[0], POLLIN, 0 });
+        _keys.push_back(0);
+#    else
+        // There is no wake up handle on Windows, wait in short steps instead.
+        timeout = std::min(timeout, 10);
+#    endif
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (const auto& entry : _entries)
+            {
+                _fds.push_back({ entry.Socket, POLLIN, 0 });
+                _keys.push_back(entry.Key);
+            }
+        }
+
+        if (_fds.empty())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+            return;
+        }
+
+        if (poll(_fds.data(), static_cast<uint32_t>(_fds.size()), timeout) <= 0)
+        {
+            return;
+        }
+
+        size_t first = 0;
+#    ifndef _WIN32
+        if (_fds[0].revents != 0)
+        {
+            char buffer[64];
+            while (read(_wakePipe[0], buffer, sizeof(buffer)) > 0)
+            {
+            }
+        }
+        first = 1;
+#    endif
+        for (size_t i = first; i < _fds.size(); i++)
+        {
+            if (_fds[i].revents != 0)
+            {
+                readyKeys.push_back(_keys[i]);
+            }
+        }
+    }
+
+    void Wake() override
+    {
+#    ifndef _WIN32
+        const char value = 1;
+        [[maybe_unused]] auto result = write(_wakePipe[1], &value, sizeof(value));
+#    endif
+    }
+};
+
+std::unique_ptr<ISocketPoller> CreateSocketPoller()
+{
+    InitialiseWSA();
+#    if defined(__linux__)
+    try
+    {
+        return std::make_unique<EpollSocketPoller>();
+    }
+    catch (const std::exception& e)
+    {
+        LOG_WARNING("%s Falling back to poll.", e.what());
+    }
+#    endif
+    return std::make_unique<PollSocketPoller>();
+}
+
 std::unique_ptr<ITcpSocket> CreateTcpSocket()
 {
     InitialiseWSA();
@@ -33,6 +33,18 @@ enum class NetworkReadPacket : int32_t
     Disconnected
 };
 
+// Maximum number of buffers gathered into one SendBuffers call.
+constexpr size_t SocketMaxSendBuffers = 64;
+
+/**
+ * A range of bytes to be sent as part of a gathered write.
+ */
+struct SocketBuffer
+{
+    const void* Data;
+    size_t Size;
+};
+
 /**
  * Represents an address and port.
  */
@@ -66,6 +78,9 @@ public:
     virtual void ConnectAsync(const std::string& address, uint16_t port) abstract;
 
     virtual size_t SendData(const void* buffer, size_t size) abstract;
+    // Sends the buffers in order with a single system call, returns the number of bytes that were sent.
+    // Only the first SocketMaxSendBuffers buffers are sent.
+    virtual size_t SendBuffers(const SocketBuffer* buffers, size_t count) abstract;
     virtual NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) abstract;
 
     virtual void SetNoDelay(bool noDelay) abstract;
@@ -98,8 +113,27 @@ public:
     virtual void Close() abstract;
 };
 
+/**
+ * Waits for incoming data on a set of TCP sockets, uses epoll where available and poll otherwise.
+ * Sockets may be added and removed while another thread is waiting.
+ */
+struct ISocketPoller
+{
+public:
+    virtual ~ISocketPoller() = default;
+
+    virtual void Add(ITcpSocket& socket, uint64_t key) abstract;
+    virtual void Remove(ITcpSocket& socket) abstract;
+
+    // Waits up to timeout milliseconds and appends the keys of readable or closed sockets to readyKeys.
+    virtual void Wait(int32_t timeout, std::vector<uint64_t>& readyKeys) abstract;
+    // Makes a thread blocked in Wait return early.
+    virtual void Wake() abstract;
+};
+
 [[nodiscard]] std::unique_ptr<ITcpSocket> CreateTcpSocket();
 [[nodiscard]] std::unique_ptr<IUdpSocket> CreateUdpSocket();
+[[nodiscard]] std::unique_ptr<ISocketPoller> CreateSocketPoller();
 [[nodiscard]] std::vector<std::unique_ptr<INetworkEndpoint>> GetBroadcastAddresses();
 
 namespace Convert
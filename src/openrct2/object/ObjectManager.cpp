@@ -15,9 +15,11 @@
 #include "../core/Console.hpp"
 #include "../core/Memory.hpp"
 #include "../localisation/StringIds.h"
+#include "../paint/PaintCache.h"
 #include "../ride/Ride.h"
 #include "../ride/RideAudio.h"
 #include "../util/Util.h"
+#include "../world/TileSummary.h"
 #include "BannerSceneryEntry.h"
 #include "LargeSceneryObject.h"
 #include "Object.h"
@@ -64,6 +66,7 @@ public:
     {
         UpdateSceneryGroupIndexes();
         ResetTypeToRideEntryIndexMap();
+        PaintCacheInvalidateAll();
     }
 
     ~ObjectManager() override
@@ -418,6 +421,7 @@ private:
         std::replace(list.begin(), list.end(), object, static_cast<Object*>(nullptr));
 
         object->Unload();
+        PaintCacheInvalidateAll();
 
         // TODO try to prevent doing a repository search
         const auto* ori = _objectRepository.FindObject(object->GetDescriptor());
@@ -500,6 +504,9 @@ private:
         // HACK Scenery window will lose its tabs after changing the scenery group indexing
         //      for now just close it, but it will be better to later tell it to invalidate the tabs
         WindowCloseByClass(WindowClass::Scenery);
+
+        // Tile summaries count path additions by their entry flags, which may have changed.
+        TileSummaryInvalidateAll();
     }
 
     ObjectEntryIndex GetPrimarySceneryGroupEntryIndex(Object* loadedObject)
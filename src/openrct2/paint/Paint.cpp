@@ -84,7 +84,7 @@ static int32_t RemapPositionToQuadrant(const PaintStruct& ps, uint8_t rotation)
     return 0;
 }
 
-static void PaintSessionAddPSToQuadrant(PaintSession& session, PaintStruct* ps)
+void PaintSessionAddPSToQuadrant(PaintSession& session, PaintStruct* ps)
 {
     const auto positionHash = RemapPositionToQuadrant(*ps, session.CurrentRotation);
 
@@ -97,6 +97,9 @@ static void PaintSessionAddPSToQuadrant(PaintSession& session, PaintStruct* ps)
 
     session.QuadrantBackIndex = std::min(session.QuadrantBackIndex, paintQuadrantIndex);
     session.QuadrantFrontIndex = std::max(session.QuadrantFrontIndex, paintQuadrantIndex);
+
+    if (session.Recording != nullptr)
+        session.Recording->Roots.push_back(ps);
 }
 
 static constexpr bool ImageWithinDPI(const ScreenCoordsXY& imagePos, const G1Element& g1, const DrawPixelInfo& dpi)
@@ -162,7 +165,7 @@ static PaintStruct* CreateNormalPaintStruct(
 
     const auto imagePos = Translate3DTo2DWithZ(session.CurrentRotation, swappedRotCoord);
 
-    if (!ImageWithinDPI(imagePos, *g1, session.DPI))
+    if (session.Recording == nullptr && !ImageWithinDPI(imagePos, *g1, session.DPI))
     {
         return nullptr;
     }
@@ -12,6 +12,7 @@
 #include "../common.h"
 #include "../core/FixedVector.h"
 #include "../drawing/Drawing.h"
+#include "../drawing/LightFX.h"
 #include "../interface/Colour.h"
 #include "../world/Location.hpp"
 #include "../world/Map.h"
@@ -19,6 +20,7 @@
 
 #include <mutex>
 #include <thread>
+#include <vector>
 
 struct EntityBase;
 struct TileElement;
@@ -212,10 +214,24 @@ struct PaintSessionCore
     ViewportInteractionItem InteractionType;
 };
 
+/**
+ * Paint structs created while the elements of a tile are being recorded for the paint cache. Images are not clipped to
+ * the DPI while recording so the result can be reused for any part of the viewport.
+ */
+struct PaintRecording
+{
+    std::vector<PaintStruct*> Structs;
+    std::vector<AttachedPaintStruct*> Attached;
+    // Structs added to a quadrant, in the order they were added.
+    std::vector<PaintStruct*> Roots;
+    std::vector<LightFXMapLight> Lights;
+};
+
 struct PaintSession : public PaintSessionCore
 {
     DrawPixelInfo DPI;
     PaintEntryPool::Chain PaintEntryChain;
+    PaintRecording* Recording{};
 
     PaintStruct* AllocateNormalPaintEntry() noexcept
     {
@@ -223,6 +239,8 @@ struct PaintSession : public PaintSessionCore
         if (entry != nullptr)
         {
             LastPS = entry->AsBasic();
+            if (Recording != nullptr)
+                Recording->Structs.push_back(LastPS);
             return LastPS;
         }
         return nullptr;
@@ -234,6 +252,8 @@ struct PaintSession : public PaintSessionCore
         if (entry != nullptr)
         {
             LastAttachedPS = entry->AsAttached();
+            if (Recording != nullptr)
+                Recording->Attached.push_back(LastAttachedPS);
             return LastAttachedPS;
         }
         return nullptr;
@@ -342,5 +362,6 @@ PaintSession* PaintSessionAlloc(DrawPixelInfo& dpi, uint32_t viewFlags);
 void PaintSessionFree(PaintSession* session);
 void PaintSessionGenerate(PaintSession& session);
 void PaintSessionArrange(PaintSessionCore& session);
+void PaintSessionAddPSToQuadrant(PaintSession& session, PaintStruct* ps);
 void PaintDrawStructs(PaintSession& session);
 void PaintDrawMoneyStructs(DrawPixelInfo& dpi, PaintStringStruct* ps);
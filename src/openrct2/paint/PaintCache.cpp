@@ -0,0 +1,656 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PaintCache.h"
+
+#include "../Cheats.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../config/Config.h"
+#include "../drawing/Drawing.h"
+#include "../drawing/LightFX.h"
+#include "../interface/Viewport.h"
+#include "../profiling/Profiling.h"
+#include "../ride/RideData.h"
+#include "../ride/TrackDesign.h"
+#include "../sprites.h"
+#include "../world/Map.h"
+#include "Paint.SessionFlags.h"
+#include "Paint.h"
+#include "tile_element/Paint.TileElement.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace OpenRCT2;
+
+// Index of a struct or element that is not set, or was not changed by the tile.
+static constexpr int16_t kIndexNull = -1;
+static constexpr int16_t kIndexUnchanged = -2;
+
+static constexpr size_t kNumShards = 64;
+static constexpr size_t kMaxVariantsPerTile = 4;
+static constexpr size_t kMaxStructsPerTile = 1024;
+static constexpr size_t kMaxBytes = 64 * 1024 * 1024;
+// More pending tile invalidations than this clear the whole cache instead.
+static constexpr size_t kMaxPendingTiles = 16384;
+
+struct PaintCacheStruct
+{
+    PaintStructBoundBox Bounds;
+    ImageId Image;
+    ScreenCoordsXY ScreenPos;
+    CoordsXY MapPos;
+    int16_t Child;
+    int16_t FirstAttached;
+    int16_t Element;
+    ViewportInteractionItem InteractionItem;
+};
+
+struct PaintCacheAttached
+{
+    ImageId Image;
+    ImageId ColourImage;
+    ScreenCoordsXY RelativePos;
+    int16_t Next;
+    bool IsMasked;
+};
+
+// A struct added to a quadrant together with its children, culled as a whole against the DPI.
+struct PaintCacheGroup
+{
+    ScreenRect Bounds;
+    int16_t Root;
+};
+
+struct PaintCacheEntry
+{
+    uint32_t ViewFlags;
+    ZoomLevel Zoom;
+    uint8_t Rotation;
+    uint64_t ElementHash;
+    std::vector<PaintCacheStruct> Structs;
+    std::vector<PaintCacheAttached> Attached;
+    std::vector<PaintCacheGroup> Groups;
+    std::vector<LightFXMapLight> Lights;
+
+    // Session state left behind by the tile.
+    int16_t LastPS;
+    int16_t LastAttachedPS;
+    int16_t WoodenSupportsPrependTo;
+    int16_t CurrentlyDrawnTileElement;
+    int16_t Surface;
+    CoordsXY SpritePosition;
+    ViewportInteractionItem InteractionType;
+    uint8_t Flags;
+
+    size_t GetSize() const
+    {
+        return sizeof(PaintCacheEntry) + Structs.capacity() * sizeof(PaintCacheStruct)
+            + Attached.capacity() * sizeof(PaintCacheAttached) + Groups.capacity() * sizeof(PaintCacheGroup)
+            + Lights.capacity() * sizeof(LightFXMapLight);
+    }
+};
+
+using PaintCacheEntryPtr = std::shared_ptr<const PaintCacheEntry>;
+
+struct PaintCacheShard
+{
+    std::mutex Mutex;
+    std::unordered_map<uint32_t, std::vector<PaintCacheEntryPtr>> Tiles;
+};
+
+static std::array<PaintCacheShard, kNumShards> _shards;
+static std::atomic<size_t> _cacheBytes = { 0 };
+
+// Only accessed from the main thread.
+static std::vector<CoordsXY> _pendingTiles;
+static bool _pendingClear = false;
+
+using PaintCacheEnvironment = std::tuple<bool, bool, bool, bool, bool, uint8_t, uint64_t, int32_t>;
+static PaintCacheEnvironment _lastEnvironment;
+
+static thread_local PaintRecording _recording;
+
+static uint32_t GetTileKey(const CoordsXY& pos)
+{
+    const auto tilePos = TileCoordsXY(pos);
+    return (static_cast<uint32_t>(static_cast<uint16_t>(tilePos.x)) << 16) | static_cast<uint16_t>(tilePos.y);
+}
+
+static PaintCacheShard& GetShard(uint32_t tileKey)
+{
+    return _shards[(tileKey ^ (tileKey >> 16)) % kNumShards];
+}
+
+// Global state read while painting tile elements that is not covered by tile invalidations.
+static PaintCacheEnvironment GetEnvironment()
+{
+    const auto& gameState = GetGameState();
+    return { gConfigGeneral.UpperCaseBanners, gConfigGeneral.TransparentWater, gConfigGeneral.LandscapeSmoothing,
+             LightFXIsAvailable(), gCheatsSandboxMode, gScreenFlags, gameState.ParkFlags, gameState.MapBaseZ };
+}
+
+static uint64_t GetElementHash(const TileElement* first, const TileElement* last)
+{
+    // FNV-1a
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    const auto* bytes = reinterpret_cast<const uint8_t*>(first);
+    const auto* end = reinterpret_cast<const uint8_t*>(last + 1);
+    for (; bytes != end; bytes++)
+    {
+        hash = (hash ^ *bytes) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+static bool IsTileSelected(const PaintSession& session, const CoordsXY& pos, const TileElement* first, const TileElement* last)
+{
+    if (session.SelectedElement >= first && session.SelectedElement <= last)
+        return true;
+
+    if (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE)
+    {
+        if (pos.x >= gMapSelectPositionA.x && pos.x <= gMapSelectPositionB.x && pos.y >= gMapSelectPositionA.y
+            && pos.y <= gMapSelectPositionB.y)
+            return true;
+    }
+    if (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_CONSTRUCT)
+    {
+        if (std::find(gMapSelectionTiles.begin(), gMapSelectionTiles.end(), pos) != gMapSelectionTiles.end())
+            return true;
+    }
+    if (gMapSelectFlags & MAP_SELECT_FLAG_ENABLE_ARROW)
+    {
+        if (pos.x == gMapSelectArrowPosition.x && pos.y == gMapSelectArrowPosition.y)
+            return true;
+    }
+    return false;
+}
+
+// Flat rides paint their vehicles as part of the track, which changes without the track element changing.
+static bool HasAnimatedTrack(const TileElement* first, const TileElement* last)
+{
+    for (const auto* element = first; element <= last; element++)
+    {
+        const auto* trackElement = element->AsTrack();
+        if (trackElement != nullptr
+            && GetRideTypeDescriptor(trackElement->GetRideType()).HasFlag(RIDE_TYPE_FLAG_FLAT_RIDE))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool CanUseCache(const PaintSession& session, const CoordsXY& pos, const TileElement* first, const TileElement* last)
+{
+    if (session.Flags & PaintSessionFlags::IsTrackPiecePreview)
+        return false;
+    if (session.ViewFlags & VIEWPORT_FLAG_CLIP_VIEW)
+        return false;
+    if (gShowSupportSegmentHeights || gPaintBlockedTiles || gPaintWidePathsAsGhost || gTrackDesignSaveMode)
+        return false;
+    return !IsTileSelected(session, pos, first, last) && !HasAnimatedTrack(first, last);
+}
+
+static PaintCacheEntryPtr FindEntry(const PaintSession& session, uint32_t tileKey)
+{
+    auto& shard = GetShard(tileKey);
+    std::lock_guard lock(shard.Mutex);
+    auto it = shard.Tiles.find(tileKey);
+    if (it == shard.Tiles.end())
+        return nullptr;
+
+    for (const auto& entry : it->second)
+    {
+        if (entry->ViewFlags == session.ViewFlags && entry->Zoom == session.DPI.zoom_level
+            && entry->Rotation == session.CurrentRotation)
+        {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+static void InsertEntry(uint32_t tileKey, PaintCacheEntryPtr entry)
+{
+    auto& shard = GetShard(tileKey);
+    std::lock_guard lock(shard.Mutex);
+    auto& variants = shard.Tiles[tileKey];
+    auto it = std::find_if(variants.begin(), variants.end(), [&entry](const PaintCacheEntryPtr& variant) {
+        return variant->ViewFlags == entry->ViewFlags && variant->Zoom == entry->Zoom
+            && variant->Rotation == entry->Rotation;
+    });
+    if (it != variants.end())
+    {
+        _cacheBytes -= (*it)->GetSize();
+        variants.erase(it);
+    }
+    else if (variants.size() >= kMaxVariantsPerTile)
+    {
+        _cacheBytes -= variants.front()->GetSize();
+        variants.erase(variants.begin());
+    }
+    _cacheBytes += entry->GetSize();
+    variants.push_back(std::move(entry));
+}
+
+static bool IsCacheableImage(ImageId imageId)
+{
+    // Scrolling text images are generated each frame into a small number of shared slots.
+    const auto index = imageId.GetIndex();
+    return index != SPR_TEMP && !(index >= SPR_SCROLLING_TEXT_START && index < SPR_SCROLLING_TEXT_END);
+}
+
+static void AddImageBounds(ScreenRect& bounds, bool& hasBounds, ImageId imageId, const ScreenCoordsXY& pos)
+{
+    const auto* g1 = GfxGetG1Element(imageId);
+    if (g1 == nullptr)
+        return;
+
+    const ScreenCoordsXY topLeft = { pos.x + g1->x_offset, pos.y + g1->y_offset };
+    const ScreenCoordsXY bottomRight = { topLeft.x + g1->width, topLeft.y + g1->height };
+    if (!hasBounds)
+    {
+        bounds = { topLeft, bottomRight };
+        hasBounds = true;
+        return;
+    }
+    bounds = { { std::min(bounds.GetLeft(), topLeft.x), std::min(bounds.GetTop(), topLeft.y) },
+               { std::max(bounds.GetRight(), bottomRight.x), std::max(bounds.GetBottom(), bottomRight.y) } };
+}
+
+template<typename T> static int16_t FindIndex(const std::vector<T*>& items, const T* item)
+{
+    auto it = std::find(items.begin(), items.end(), item);
+    if (it == items.end())
+        return kIndexNull;
+    return static_cast<int16_t>(std::distance(items.begin(), it));
+}
+
+// Stores the index of a session pointer, returns false if it points to something the tile did not create.
+template<typename T>
+static bool GetStateIndex(const std::vector<T*>& items, const T* before, const T* after, int16_t& index)
+{
+    if (after == before)
+    {
+        index = kIndexUnchanged;
+        return true;
+    }
+    if (after == nullptr)
+    {
+        index = kIndexNull;
+        return true;
+    }
+    index = FindIndex(items, after);
+    return index != kIndexNull;
+}
+
+static bool GetElementIndex(const PaintCacheTile& tile, const TileElement* element, int16_t& index)
+{
+    if (element == nullptr)
+    {
+        index = kIndexNull;
+        return true;
+    }
+    if (element < tile.FirstElement || element > tile.LastElement)
+        return false;
+    index = static_cast<int16_t>(element - tile.FirstElement);
+    return true;
+}
+
+static std::shared_ptr<PaintCacheEntry> CreateEntry(const PaintSession& session, const PaintCacheTile& tile)
+{
+    const auto& recording = _recording;
+    if (recording.Structs.size() > kMaxStructsPerTile || recording.Attached.size() > kMaxStructsPerTile)
+        return nullptr;
+
+    auto entry = std::make_shared<PaintCacheEntry>();
+    entry->ViewFlags = session.ViewFlags;
+    entry->Zoom = session.DPI.zoom_level;
+    entry->Rotation = session.CurrentRotation;
+    entry->ElementHash = tile.ElementHash;
+    entry->Structs.resize(recording.Structs.size());
+    entry->Attached.resize(recording.Attached.size());
+    entry->Lights = recording.Lights;
+
+    // Every struct must be reachable from a root, otherwise it was linked to a struct of another tile.
+    std::vector<bool> reached(recording.Structs.size());
+    std::vector<bool> reachedAttached(recording.Attached.size());
+    for (const auto* root : recording.Roots)
+    {
+        PaintCacheGroup group{};
+        group.Root = FindIndex(recording.Structs, root);
+        if (group.Root == kIndexNull)
+            return nullptr;
+
+        bool hasBounds = false;
+        for (auto* ps = root; ps != nullptr; ps = ps->Children)
+        {
+            const auto index = FindIndex(recording.Structs, ps);
+            if (index == kIndexNull || reached[index])
+                return nullptr;
+            reached[index] = true;
+
+            if (ps->Entity != nullptr || !IsCacheableImage(ps->image_id))
+                return nullptr;
+
+            auto& cached = entry->Structs[index];
+            cached.Bounds = ps->Bounds;
+            cached.Image = ps->image_id;
+            cached.ScreenPos = ps->ScreenPos;
+            cached.MapPos = ps->MapPos;
+            cached.InteractionItem = ps->InteractionItem;
+            cached.Child = ps->Children != nullptr ? FindIndex(recording.Structs, ps->Children) : kIndexNull;
+            cached.FirstAttached = ps->Attached != nullptr ? FindIndex(recording.Attached, ps->Attached) : kIndexNull;
+            if (!GetElementIndex(tile, ps->Element, cached.Element))
+                return nullptr;
+            if (ps->Attached != nullptr && cached.FirstAttached == kIndexNull)
+                return nullptr;
+            AddImageBounds(group.Bounds, hasBounds, ps->image_id, ps->ScreenPos);
+
+            for (auto* attached = ps->Attached; attached != nullptr; attached = attached->NextEntry)
+            {
+                const auto attachedIndex = FindIndex(recording.Attached, attached);
+                if (attachedIndex == kIndexNull || reachedAttached[attachedIndex])
+                    return nullptr;
+                reachedAttached[attachedIndex] = true;
+
+                if (!IsCacheableImage(attached->image_id))
+                    return nullptr;
+
+                auto& cachedAttached = entry->Attached[attachedIndex];
+                cachedAttached.Image = attached->image_id;
+                cachedAttached.ColourImage = attached->ColourImageId;
+                cachedAttached.RelativePos = attached->RelativePos;
+                cachedAttached.IsMasked = attached->IsMasked;
+                cachedAttached.Next = attached->NextEntry != nullptr ? FindIndex(recording.Attached, attached->NextEntry)
+                                                                     : kIndexNull;
+                if (attached->NextEntry != nullptr && cachedAttached.Next == kIndexNull)
+                    return nullptr;
+                AddImageBounds(group.Bounds, hasBounds, attached->image_id, ps->ScreenPos + attached->RelativePos);
+            }
+        }
+        if (hasBounds)
+        {
+            entry->Groups.push_back(group);
+        }
+    }
+    if (std::find(reached.begin(), reached.end(), false) != reached.end()
+        || std::find(reachedAttached.begin(), reachedAttached.end(), false) != reachedAttached.end())
+    {
+        return nullptr;
+    }
+
+    if (!GetStateIndex<PaintStruct>(recording.Structs, tile.LastPS, session.LastPS, entry->LastPS)
+        || !GetStateIndex<AttachedPaintStruct>(
+            recording.Attached, tile.LastAttachedPS, session.LastAttachedPS, entry->LastAttachedPS)
+        || !GetStateIndex<PaintStruct>(
+            recording.Structs, tile.WoodenSupportsPrependTo, session.WoodenSupportsPrependTo,
+            entry->WoodenSupportsPrependTo))
+    {
+        return nullptr;
+    }
+
+    entry->CurrentlyDrawnTileElement = kIndexUnchanged;
+    if (session.CurrentlyDrawnTileElement != tile.CurrentlyDrawnTileElement
+        && !GetElementIndex(tile, session.CurrentlyDrawnTileElement, entry->CurrentlyDrawnTileElement))
+    {
+        return nullptr;
+    }
+    entry->Surface = kIndexUnchanged;
+    if (session.Surface != tile.Surface
+        && !GetElementIndex(tile, reinterpret_cast<const TileElement*>(session.Surface), entry->Surface))
+    {
+        return nullptr;
+    }
+    entry->SpritePosition = session.SpritePosition;
+    entry->InteractionType = session.InteractionType;
+    entry->Flags = session.Flags;
+    return entry;
+}
+
+static bool IsGroupVisible(const PaintCacheGroup& group, const DrawPixelInfo& dpi)
+{
+    return group.Bounds.GetRight() > dpi.x && group.Bounds.GetBottom() > dpi.y && group.Bounds.GetLeft() < dpi.x + dpi.width
+        && group.Bounds.GetTop() < dpi.y + dpi.height;
+}
+
+static void ReplayEntry(PaintSession& session, const PaintCacheEntry& entry, const PaintCacheTile& tile)
+{
+    static thread_local std::vector<PaintStruct*> structs;
+    static thread_local std::vector<AttachedPaintStruct*> attached;
+    structs.assign(entry.Structs.size(), nullptr);
+    attached.assign(entry.Attached.size(), nullptr);
+
+    // Lights are added by the paint functions of the elements whether or not their images are visible.
+    LightFXAddMapLights(entry.Lights);
+
+    auto* firstElement = const_cast<TileElement*>(tile.FirstElement);
+    for (const auto& group : entry.Groups)
+    {
+        if (!IsGroupVisible(group, session.DPI))
+            continue;
+
+        PaintStruct* parent = nullptr;
+        for (auto index = group.Root; index != kIndexNull; index = entry.Structs[index].Child)
+        {
+            const auto& cached = entry.Structs[index];
+            auto* ps = session.AllocateNormalPaintEntry();
+            if (ps == nullptr)
+                return;
+
+            ps->Bounds = cached.Bounds;
+            ps->image_id = cached.Image;
+            ps->ScreenPos = cached.ScreenPos;
+            ps->MapPos = cached.MapPos;
+            ps->InteractionItem = cached.InteractionItem;
+            ps->Element = cached.Element != kIndexNull ? firstElement + cached.Element : nullptr;
+            ps->Entity = nullptr;
+            ps->Attached = nullptr;
+            ps->Children = nullptr;
+            ps->NextQuadrantEntry = nullptr;
+            structs[index] = ps;
+
+            AttachedPaintStruct* previousAttached = nullptr;
+            for (auto attachedIndex = cached.FirstAttached; attachedIndex != kIndexNull;
+                 attachedIndex = entry.Attached[attachedIndex].Next)
+            {
+                const auto& cachedAttached = entry.Attached[attachedIndex];
+                auto* attachedPs = session.AllocateAttachedPaintEntry();
+                if (attachedPs == nullptr)
+                    return;
+
+                attachedPs->image_id = cachedAttached.Image;
+                attachedPs->ColourImageId = cachedAttached.ColourImage;
+                attachedPs->RelativePos = cachedAttached.RelativePos;
+                attachedPs->IsMasked = cachedAttached.IsMasked;
+                attachedPs->NextEntry = nullptr;
+                if (previousAttached == nullptr)
+                    ps->Attached = attachedPs;
+                else
+                    previousAttached->NextEntry = attachedPs;
+                previousAttached = attachedPs;
+                attached[attachedIndex] = attachedPs;
+            }
+
+            if (parent == nullptr)
+                PaintSessionAddPSToQuadrant(session, ps);
+            else
+                parent->Children = ps;
+            parent = ps;
+        }
+    }
+
+    // Leave the session as painting the tile would have, structs that were culled count as clipped.
+    if (entry.LastPS != kIndexUnchanged)
+        session.LastPS = entry.LastPS != kIndexNull ? structs[entry.LastPS] : nullptr;
+    if (entry.LastAttachedPS != kIndexUnchanged)
+        session.LastAttachedPS = entry.LastAttachedPS != kIndexNull ? attached[entry.LastAttachedPS] : nullptr;
+    if (entry.WoodenSupportsPrependTo != kIndexUnchanged)
+        session.WoodenSupportsPrependTo = entry.WoodenSupportsPrependTo != kIndexNull
+            ? structs[entry.WoodenSupportsPrependTo]
+            : nullptr;
+    if (entry.CurrentlyDrawnTileElement != kIndexUnchanged)
+        session.CurrentlyDrawnTileElement = entry.CurrentlyDrawnTileElement != kIndexNull
+            ? firstElement + entry.CurrentlyDrawnTileElement
+            : nullptr;
+    if (entry.Surface != kIndexUnchanged)
+        session.Surface = entry.Surface != kIndexNull ? firstElement[entry.Surface].AsSurface() : nullptr;
+    session.SpritePosition = entry.SpritePosition;
+    session.InteractionType = entry.InteractionType;
+    session.Flags = entry.Flags;
+}
+
+bool PaintCacheReplayTile(PaintSession& session, const CoordsXY& pos, const TileElement* firstElement, PaintCacheTile& tile)
+{
+    tile.Recording = false;
+
+    const auto* lastElement = firstElement;
+    while (!lastElement->IsLastForTile())
+        lastElement++;
+    if (!CanUseCache(session, pos, firstElement, lastElement))
+        return false;
+
+    tile.Pos = pos;
+    tile.FirstElement = firstElement;
+    tile.LastElement = lastElement;
+    tile.ElementHash = GetElementHash(firstElement, lastElement);
+
+    auto entry = FindEntry(session, GetTileKey(pos));
+    if (entry != nullptr && entry->ElementHash == tile.ElementHash)
+    {
+        ReplayEntry(session, *entry, tile);
+        return true;
+    }
+
+    _recording.Structs.clear();
+    _recording.Attached.clear();
+    _recording.Roots.clear();
+    _recording.Lights.clear();
+    LightFXSetMapLightRecording(&_recording.Lights);
+    tile.Recording = true;
+    tile.LastPS = session.LastPS;
+    tile.LastAttachedPS = session.LastAttachedPS;
+    tile.WoodenSupportsPrependTo = session.WoodenSupportsPrependTo;
+    tile.CurrentlyDrawnTileElement = session.CurrentlyDrawnTileElement;
+    tile.Surface = session.Surface;
+    session.Recording = &_recording;
+    return false;
+}
+
+void PaintCacheStoreTile(PaintSession& session, PaintCacheTile& tile)
+{
+    if (!tile.Recording)
+        return;
+
+    session.Recording = nullptr;
+    LightFXSetMapLightRecording(nullptr);
+    tile.Recording = false;
+
+    auto entry = CreateEntry(session, tile);
+    if (entry != nullptr)
+    {
+        InsertEntry(GetTileKey(tile.Pos), std::move(entry));
+    }
+}
+
+void PaintCacheInvalidateTile(const CoordsXY& pos)
+{
+    if (_pendingClear)
+        return;
+
+    if (_pendingTiles.size() >= kMaxPendingTiles)
+    {
+        PaintCacheInvalidateAll();
+        return;
+    }
+    _pendingTiles.push_back(pos);
+}
+
+void PaintCacheInvalidateRegion(const CoordsXY& mins, const CoordsXY& maxs)
+{
+    for (int32_t y = mins.y; y <= maxs.y; y += COORDS_XY_STEP)
+    {
+        for (int32_t x = mins.x; x <= maxs.x; x += COORDS_XY_STEP)
+        {
+            PaintCacheInvalidateTile({ x, y });
+            if (_pendingClear)
+                return;
+        }
+    }
+}
+
+void PaintCacheInvalidateAll()
+{
+    _pendingClear = true;
+    _pendingTiles.clear();
+}
+
+static void EraseTile(const CoordsXY& pos)
+{
+    const auto tileKey = GetTileKey(pos);
+    auto& shard = GetShard(tileKey);
+    std::lock_guard lock(shard.Mutex);
+    auto it = shard.Tiles.find(tileKey);
+    if (it == shard.Tiles.end())
+        return;
+
+    for (const auto& entry : it->second)
+    {
+        _cacheBytes -= entry->GetSize();
+    }
+    shard.Tiles.erase(it);
+}
+
+void PaintCacheFlush()
+{
+    PROFILED_FUNCTION();
+
+    const auto environment = GetEnvironment();
+    if (environment != _lastEnvironment || _cacheBytes > kMaxBytes)
+    {
+        _lastEnvironment = environment;
+        _pendingClear = true;
+    }
+
+    if (_pendingClear)
+    {
+        for (auto& shard : _shards)
+        {
+            std::lock_guard lock(shard.Mutex);
+            shard.Tiles.clear();
+        }
+        _cacheBytes = 0;
+        _pendingClear = false;
+        _pendingTiles.clear();
+        return;
+    }
+
+    // The paint of a tile also depends on its neighbours, e.g. for surface edges.
+    for (const auto& pos : _pendingTiles)
+    {
+        for (int32_t dy = -COORDS_XY_STEP; dy <= COORDS_XY_STEP; dy += COORDS_XY_STEP)
+        {
+            for (int32_t dx = -COORDS_XY_STEP; dx <= COORDS_XY_STEP; dx += COORDS_XY_STEP)
+            {
+                EraseTile(pos + CoordsXY{ dx, dy });
+            }
+        }
+    }
+    _pendingTiles.clear();
+}
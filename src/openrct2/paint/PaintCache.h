@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+
+struct PaintSession;
+struct PaintStruct;
+struct AttachedPaintStruct;
+struct SurfaceElement;
+struct TileElement;
+
+/**
+ * State of a tile that is being painted through the paint cache, passed from PaintCacheReplayTile to
+ * PaintCacheStoreTile.
+ */
+struct PaintCacheTile
+{
+    CoordsXY Pos;
+    const TileElement* FirstElement{};
+    const TileElement* LastElement{};
+    uint64_t ElementHash{};
+    bool Recording{};
+
+    // Session state from before the tile was recorded, to tell which of it the tile changed.
+    PaintStruct* LastPS{};
+    AttachedPaintStruct* LastAttachedPS{};
+    PaintStruct* WoodenSupportsPrependTo{};
+    TileElement* CurrentlyDrawnTileElement{};
+    const SurfaceElement* Surface{};
+};
+
+/**
+ * The paint structs of the elements on a tile are cached per rotation, zoom level and view flags, so tiles that have
+ * not changed are not set up again every frame. Entries are validated against the tile element data when used and are
+ * dropped when the tile or one of its neighbours is invalidated, or the whole screen is invalidated. Tiles whose paint
+ * depends on state that is not tracked, e.g. scrolling text, flat rides, selections or clipping, are always set up.
+ * Lights added while a tile is recorded are stored with its entry and added again when it is replayed.
+ *
+ * Replays the cached paint structs for the tile at pos into the session if possible. Otherwise the tile elements must be
+ * painted as usual, and when false is returned recording may have been started, which PaintCacheStoreTile finishes.
+ */
+bool PaintCacheReplayTile(PaintSession& session, const CoordsXY& pos, const TileElement* firstElement, PaintCacheTile& tile);
+void PaintCacheStoreTile(PaintSession& session, PaintCacheTile& tile);
+
+// Invalidations are applied by PaintCacheFlush which must not be called while tiles are being painted.
+void PaintCacheInvalidateTile(const CoordsXY& pos);
+void PaintCacheInvalidateRegion(const CoordsXY& mins, const CoordsXY& maxs);
+void PaintCacheInvalidateAll();
+void PaintCacheFlush();
@@ -19,10 +19,12 @@
 #include "../drawing/IDrawingEngine.h"
 #include "../interface/Chat.h"
 #include "../interface/InteractiveConsole.h"
+#include "../interface/Viewport.h"
 #include "../localisation/FormatCodes.h"
 #include "../localisation/Formatting.h"
 #include "../localisation/Language.h"
 #include "../paint/Paint.h"
+#include "../paint/PaintCache.h"
 #include "../profiling/Profiling.h"
 #include "../title/TitleScreen.h"
 #include "../ui/UiContext.h"
@@ -42,6 +44,9 @@ void Painter::Paint(IDrawingEngine& de)
 {
     PROFILED_FUNCTION();
 
+    // Project the map and entity changes since the last frame into the viewports before drawing them.
+    ViewportsFlushInvalidations();
+
     auto dpi = de.GetDrawingPixelInfo();
     if (gIntroState != IntroState::None)
     {
@@ -137,6 +142,9 @@ PaintSession* Painter::CreateSession(DrawPixelInfo& dpi, uint32_t viewFlags)
 {
     PROFILED_FUNCTION();
 
+    // Sessions are created before any of them is painted, so invalidations can be applied here.
+    PaintCacheFlush();
+
     PaintSession* session = nullptr;
 
     if (_freePaintSessions.empty() == false)
@@ -160,6 +168,7 @@ PaintSession* Painter::CreateSession(DrawPixelInfo& dpi, uint32_t viewFlags)
     session->QuadrantFrontIndex = 0;
     session->PaintEntryChain = _paintStructPool.Create();
     session->Flags = 0;
+    session->Recording = nullptr;
 
     std::fill(std::begin(session->Quadrants), std::end(session->Quadrants), nullptr);
     session->PaintHead = nullptr;
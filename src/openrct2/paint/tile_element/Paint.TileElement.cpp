@@ -29,6 +29,7 @@
 #include "../../world/Surface.h"
 #include "../Paint.SessionFlags.h"
 #include "../Paint.h"
+#include "../PaintCache.h"
 #include "../Supports.h"
 #include "../VirtualFloor.h"
 #include "Paint.Surface.h"
@@ -109,6 +110,85 @@ static void BlankTilesPaint(PaintSession& session, int32_t x, int32_t y)
 
 bool gShowSupportSegmentHeights = false;
 
+static void PaintTileElements(PaintSession& session, TileElement* tile_element)
+{
+    uint8_t rotation = session.CurrentRotation;
+    int32_t previousBaseZ = 0;
+    do
+    {
+        if (tile_element->IsInvisible())
+        {
+            continue;
+        }
+
+        // Only paint tile_elements below the clip height.
+        if ((session.ViewFlags & VIEWPORT_FLAG_CLIP_VIEW) && (tile_element->GetBaseZ() > gClipHeight * COORDS_Z_STEP))
+            continue;
+
+        Direction direction = tile_element->GetDirectionWithOffset(rotation);
+        int32_t baseZ = tile_element->GetBaseZ();
+
+        // If we are on a new baseZ level, look through elements on the
+        //  same baseZ and store any types might be relevant to others
+        if (baseZ != previousBaseZ)
+        {
+            previousBaseZ = baseZ;
+            session.PathElementOnSameHeight = nullptr;
+            session.TrackElementOnSameHeight = nullptr;
+            const TileElement* tile_element_sub_iterator = tile_element;
+            while (!(tile_element_sub_iterator++)->IsLastForTile())
+            {
+                if (tile_element->IsInvisible())
+                {
+                    continue;
+                }
+
+                if (tile_element_sub_iterator->GetBaseZ() != tile_element->GetBaseZ())
+                {
+                    break;
+                }
+                auto type = tile_element_sub_iterator->GetType();
+                if (type == TileElementType::Path)
+                    session.PathElementOnSameHeight = tile_element_sub_iterator;
+                else if (type == TileElementType::Track)
+                    session.TrackElementOnSameHeight = tile_element_sub_iterator;
+            }
+        }
+
+        CoordsXY mapPosition = session.MapPosition;
+        session.CurrentlyDrawnTileElement = tile_element;
+        // Setup the painting of for example: the underground, signs, rides, scenery, etc.
+        switch (tile_element->GetType())
+        {
+            case TileElementType::Surface:
+                PaintSurface(session, direction, baseZ, *(tile_element->AsSurface()));
+                break;
+            case TileElementType::Path:
+                PaintPath(session, baseZ, *(tile_element->AsPath()));
+                break;
+            case TileElementType::Track:
+                PaintTrack(session, direction, baseZ, *(tile_element->AsTrack()));
+                break;
+            case TileElementType::SmallScenery:
+                PaintSmallScenery(session, direction, baseZ, *(tile_element->AsSmallScenery()));
+                break;
+            case TileElementType::Entrance:
+                PaintEntrance(session, direction, baseZ, *(tile_element->AsEntrance()));
+                break;
+            case TileElementType::Wall:
+                PaintWall(session, direction, baseZ, *(tile_element->AsWall()));
+                break;
+            case TileElementType::LargeScenery:
+                PaintLargeScenery(session, direction, baseZ, *(tile_element->AsLargeScenery()));
+                break;
+            case TileElementType::Banner:
+                PaintBanner(session, direction, baseZ, *(tile_element->AsBanner()));
+                break;
+        }
+        session.MapPosition = mapPosition;
+    } while (!(tile_element++)->IsLastForTile());
+}
+
 /**
  *
  *  rct2: 0x0068B3FB
@@ -213,80 +293,12 @@ static void PaintTileElementBase(PaintSession& session, const CoordsXY& origCoor
     session.SpritePosition.y = coords.y;
     session.Flags &= ~PaintSessionFlags::PassedSurface;
 
-    int32_t previousBaseZ = 0;
-    do
+    PaintCacheTile cacheTile;
+    if (!PaintCacheReplayTile(session, session.MapPosition, tile_element, cacheTile))
     {
-        if (tile_element->IsInvisible())
-        {
-            continue;
-        }
-
-        // Only paint tile_elements below the clip height.
-        if ((session.ViewFlags & VIEWPORT_FLAG_CLIP_VIEW) && (tile_element->GetBaseZ() > gClipHeight * COORDS_Z_STEP))
-            continue;
-
-        Direction direction = tile_element->GetDirectionWithOffset(rotation);
-        int32_t baseZ = tile_element->GetBaseZ();
-
-        // If we are on a new baseZ level, look through elements on the
-        //  same baseZ and store any types might be relevant to others
-        if (baseZ != previousBaseZ)
-        {
-            previousBaseZ = baseZ;
-            session.PathElementOnSameHeight = nullptr;
-            session.TrackElementOnSameHeight = nullptr;
-            const TileElement* tile_element_sub_iterator = tile_element;
-            while (!(tile_element_sub_iterator++)->IsLastForTile())
-            {
-                if (tile_element->IsInvisible())
-                {
-                    continue;
-                }
-
-                if (tile_element_sub_iterator->GetBaseZ() != tile_element->GetBaseZ())
-                {
-                    break;
-                }
-                auto type = tile_element_sub_iterator->GetType();
-                if (type == TileElementType::Path)
-                    session.PathElementOnSameHeight = tile_element_sub_iterator;
-                else if (type == TileElementType::Track)
-                    session.TrackElementOnSameHeight = tile_element_sub_iterator;
-            }
-        }
-
-        CoordsXY mapPosition = session.MapPosition;
-        session.CurrentlyDrawnTileElement = tile_element;
-        // Setup the painting of for example: the underground, signs, rides, scenery, etc.
-        switch (tile_element->GetType())
-        {
-            case TileElementType::Surface:
-                PaintSurface(session, direction, baseZ, *(tile_element->AsSurface()));
-                break;
-            case TileElementType::Path:
-                PaintPath(session, baseZ, *(tile_element->AsPath()));
-                break;
-            case TileElementType::Track:
-                PaintTrack(session, direction, baseZ, *(tile_element->AsTrack()));
-                break;
-            case TileElementType::SmallScenery:
-                PaintSmallScenery(session, direction, baseZ, *(tile_element->AsSmallScenery()));
-                break;
-            case TileElementType::Entrance:
-                PaintEntrance(session, direction, baseZ, *(tile_element->AsEntrance()));
-                break;
-            case TileElementType::Wall:
-                PaintWall(session, direction, baseZ, *(tile_element->AsWall()));
-                break;
-            case TileElementType::LargeScenery:
-                PaintLargeScenery(session, direction, baseZ, *(tile_element->AsLargeScenery()));
-                break;
-            case TileElementType::Banner:
-                PaintBanner(session, direction, baseZ, *(tile_element->AsBanner()));
-                break;
-        }
-        session.MapPosition = mapPosition;
-    } while (!(tile_element++)->IsLastForTile());
+        PaintTileElements(session, tile_element);
+        PaintCacheStoreTile(session, cacheTile);
+    }
 
     if (gConfigGeneral.VirtualFloorStyle != VirtualFloorStyles::Off && partOfVirtualFloor)
     {
@@ -298,7 +310,7 @@ static void PaintTileElementBase(PaintSession& session, const CoordsXY& origCoor
         return;
     }
 
-    if ((tile_element - 1)->GetType() == TileElementType::Surface)
+    if (element->GetType() == TileElementType::Surface)
     {
         return;
     }
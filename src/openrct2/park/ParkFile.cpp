@@ -102,8 +102,10 @@ namespace OpenRCT2
         ObjectList RequiredObjects;
         std::vector<const ObjectRepositoryItem*> ExportObjectsList;
         bool OmitTracklessRides{};
+        uint32_t Compression = OrcaStream::COMPRESSION_GZIP_CHUNKED;
 
     private:
+        std::unique_ptr<FileStream> _fileStream;
         std::unique_ptr<OrcaStream> _os;
         ObjectEntryIndex _pathToSurfaceMap[MAX_PATH_OBJECTS];
         ObjectEntryIndex _pathToQueueSurfaceMap[MAX_PATH_OBJECTS];
@@ -118,6 +120,16 @@ namespace OpenRCT2
             }
         }
 
+        void LoadChunks(IStream& stream)
+        {
+            _os = std::make_unique<OrcaStream>(stream, OrcaStream::Mode::READING);
+            ThrowIfIncompatibleVersion();
+
+            RequiredObjects = {};
+            ReadWriteObjectsChunk(*_os);
+            ReadWritePackedObjectsChunk(*_os);
+        }
+
     public:
         bool IsSemiCompatibleVersion(uint32_t& minVersion, uint32_t& targetVersion)
         {
@@ -129,23 +141,24 @@ namespace OpenRCT2
 
         void Load(const std::string_view path)
         {
-            FileStream fs(path, FILE_MODE_OPEN);
-            Load(fs);
+            // Chunks are only read from the file when they are needed, so it stays open until the park is imported
+            _fileStream = std::make_unique<FileStream>(path, FILE_MODE_OPEN);
+            LoadChunks(*_fileStream);
         }
 
         void Load(IStream& stream)
         {
-            _os = std::make_unique<OrcaStream>(stream, OrcaStream::Mode::READING);
-            ThrowIfIncompatibleVersion();
+            LoadChunks(stream);
 
-            RequiredObjects = {};
-            ReadWriteObjectsChunk(*_os);
-            ReadWritePackedObjectsChunk(*_os);
+            // The stream is owned by the caller and may be gone by the time the park is imported
+            _os->ReadCompressedData();
         }
 
         void Import(GameState_t& gameState)
         {
             auto& os = *_os;
+            os.DecompressAllChunks();
+            _fileStream.reset();
             ReadWriteTilesChunk(gameState, os);
             ReadWriteBannersChunk(gameState, os);
             ReadWriteRidesChunk(gameState, os);
@@ -177,6 +190,7 @@ namespace OpenRCT2
             header.Magic = PARK_FILE_MAGIC;
             header.TargetVersion = PARK_FILE_CURRENT_VERSION;
             header.MinVersion = PARK_FILE_MIN_VERSION;
+            header.Compression = Compression;
 
             ReadWriteAuthoringChunk(os);
             ReadWriteObjectsChunk(os);
@@ -1078,7 +1092,8 @@ namespace OpenRCT2
                         std::vector<TileElement> tileElements;
                         tileElements.resize(numElements);
                         cs.Read(tileElements.data(), tileElements.size() * sizeof(TileElement));
-                        SetTileElements(std::move(tileElements));
+                        SetTileElements(
+                            std::move(tileElements), { MAXIMUM_MAP_SIZE_TECHNICAL, MAXIMUM_MAP_SIZE_TECHNICAL });
                         {
                             TileElementIterator it;
                             TileElementIteratorBegin(&it);
@@ -2603,6 +2618,47 @@ int32_t ScenarioSave(GameState_t& gameState, u8string_view path, int32_t flags)
     return result;
 }
 
+bool ScenarioSaveSnapshot(GameState_t& gameState, MemoryStream& snapshot, int32_t flags)
+{
+    gIsAutosave = flags & S6_SAVE_FLAG_AUTOMATIC;
+
+    PrepareMapForSave();
+
+    try
+    {
+        // Compression is the slowest part of saving, it is left to ScenarioWriteSnapshot.
+        auto parkFile = std::make_unique<OpenRCT2::ParkFile>();
+        parkFile->OmitTracklessRides = true;
+        parkFile->Compression = OrcaStream::COMPRESSION_NONE;
+        parkFile->Save(gameState, snapshot);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR(e.what());
+        return false;
+    }
+}
+
+bool ScenarioWriteSnapshot(MemoryStream& snapshot, u8string_view path)
+{
+    try
+    {
+        snapshot.SetPosition(0);
+        OrcaStream src(snapshot, OrcaStream::Mode::READING);
+
+        FileStream fs(path, FILE_MODE_WRITE);
+        OrcaStream dst(fs, OrcaStream::Mode::WRITING);
+        src.CopyChunksTo(dst);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR(e.what());
+        return false;
+    }
+}
+
 class ParkFileImporter final : public IParkImporter
 {
 private:
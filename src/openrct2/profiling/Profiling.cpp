@@ -13,6 +13,7 @@
 #include <chrono>
 #include <fstream>
 #include <iomanip>
+#include <memory>
 #include <stack>
 
 namespace OpenRCT2::Profiling
@@ -39,6 +40,69 @@ namespace OpenRCT2::Profiling
         using Clock = std::chrono::high_resolution_clock;
         using Tp = Clock::time_point;
 
+        static constexpr size_t TraceBufferSize = 1u << 17;
+
+        struct TraceEntry
+        {
+            std::atomic<const Function*> Func{};
+            std::atomic<int64_t> BeginNs{};
+            std::atomic<int64_t> EndNs{};
+        };
+
+        // Only written by the thread it belongs to, the export reads it while the thread may still be writing.
+        // ClaimIndex is advanced before an entry is written and WriteIndex after, so a reader can tell from ClaimIndex
+        // which of the entries it copied may have been overwritten during the copy.
+        struct TraceBuffer
+        {
+            uint32_t ThreadIndex{};
+            std::atomic<uint64_t> ClaimIndex{};
+            std::atomic<uint64_t> WriteIndex{};
+            std::array<TraceEntry, TraceBufferSize> Entries;
+        };
+
+        static std::atomic<bool> _tracing = false;
+        static std::atomic<int64_t> _traceStartNs = 0;
+        static std::mutex _traceBuffersMutex;
+        static std::vector<std::unique_ptr<TraceBuffer>> _traceBuffers;
+
+        // Buffers are kept after their thread has finished so the export can still read them.
+        static thread_local TraceBuffer* _traceBuffer = nullptr;
+
+        static TraceBuffer& GetThreadTraceBuffer()
+        {
+            if (_traceBuffer == nullptr)
+            {
+                auto buffer = std::make_unique<TraceBuffer>();
+                std::scoped_lock lock(_traceBuffersMutex);
+                buffer->ThreadIndex = static_cast<uint32_t>(_traceBuffers.size() + 1);
+                _traceBuffer = buffer.get();
+                _traceBuffers.push_back(std::move(buffer));
+            }
+            return *_traceBuffer;
+        }
+
+        int64_t TraceNow()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+
+        void TraceFunction(const Function& func, int64_t beginNs)
+        {
+            const auto endNs = TraceNow();
+
+            auto& buffer = GetThreadTraceBuffer();
+            const auto index = buffer.WriteIndex.load(std::memory_order_relaxed);
+            buffer.ClaimIndex.store(index + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            auto& entry = buffer.Entries[index % TraceBufferSize];
+            entry.Func.store(&func, std::memory_order_relaxed);
+            entry.BeginNs.store(beginNs, std::memory_order_relaxed);
+            entry.EndNs.store(endNs, std::memory_order_relaxed);
+            buffer.WriteIndex.store(index + 1, std::memory_order_release);
+        }
+
         struct FunctionEntry
         {
             FunctionInternal* Parent;
@@ -120,13 +184,47 @@ namespace OpenRCT2::Profiling
             return Registry;
         }
 
+        std::vector<Counter*>& GetCounterRegistry()
+        {
+            static std::vector<Counter*> Registry;
+            return Registry;
+        }
+
     } // namespace Detail
 
+    void StartTrace()
+    {
+        // Entries from an earlier trace are skipped by their time rather than cleared, as threads may be writing them.
+        Detail::_traceStartNs = Detail::TraceNow();
+        Detail::_tracing = true;
+    }
+
+    void StopTrace()
+    {
+        Detail::_tracing = false;
+    }
+
+    bool IsTracing()
+    {
+        return Detail::_tracing.load(std::memory_order_relaxed);
+    }
+
+    Counter::Counter(const char* name)
+        : _name(name)
+    {
+        Detail::GetCounterRegistry().push_back(this);
+    }
+
     const std::vector<Function*>& GetData()
     {
         return Detail::GetRegistry();
     }
 
+    const std::vector<Counter*>& GetCounters()
+    {
+        return Detail::GetCounterRegistry();
+    }
+
     void ResetData()
     {
         for (auto* func : Detail::GetRegistry())
@@ -137,10 +235,16 @@ namespace OpenRCT2::Profiling
             funcInternal->CallCount = 0;
             funcInternal->MinTimeUs = 0.0;
             funcInternal->MaxTimeUs = 0.0;
+            funcInternal->TotalTimeUs = 0.0;
             funcInternal->SampleIterator = 0;
             funcInternal->Children.clear();
             funcInternal->Parents.clear();
         }
+
+        for (auto* counter : Detail::GetCounterRegistry())
+        {
+            counter->Reset();
+        }
     }
 
     bool ExportCSV(const std::string& filePath)
@@ -171,4 +275,88 @@ namespace OpenRCT2::Profiling
         return true;
     }
 
+    static void WriteJsonString(std::ostream& out, const char* str)
+    {
+        out << '"';
+        for (; *str != '\0'; str++)
+        {
+            const auto c = static_cast<unsigned char>(*str);
+            if (c == '"' || c == '\\')
+                out << '\\' << *str;
+            else if (c < 0x20)
+                out << ' ';
+            else
+                out << *str;
+        }
+        out << '"';
+    }
+
+    bool ExportChromeTrace(const std::string& filePath)
+    {
+        struct Event
+        {
+            const Function* Func;
+            int64_t BeginNs;
+            int64_t EndNs;
+        };
+
+        std::ofstream out(filePath);
+        if (!out.is_open())
+            return false;
+
+        const auto traceStartNs = Detail::_traceStartNs.load();
+
+        out << "{\"traceEvents\":[";
+        out << std::fixed << std::setprecision(3);
+        bool first = true;
+
+        // Buffers are never freed, so they can be read without holding the lock.
+        std::vector<const Detail::TraceBuffer*> buffers;
+        {
+            std::scoped_lock lock(Detail::_traceBuffersMutex);
+            for (const auto& buffer : Detail::_traceBuffers)
+            {
+                buffers.push_back(buffer.get());
+            }
+        }
+
+        std::vector<Event> events;
+        for (const auto* buffer : buffers)
+        {
+            const auto endIndex = buffer->WriteIndex.load(std::memory_order_acquire);
+            const auto beginIndex = endIndex > Detail::TraceBufferSize ? endIndex - Detail::TraceBufferSize : 0;
+            events.clear();
+            for (auto i = beginIndex; i < endIndex; i++)
+            {
+                const auto& entry = buffer->Entries[i % Detail::TraceBufferSize];
+                events.push_back({ entry.Func.load(std::memory_order_relaxed), entry.BeginNs.load(std::memory_order_relaxed),
+                                   entry.EndNs.load(std::memory_order_relaxed) });
+            }
+
+            // Drop the entries the thread may have started overwriting while they were copied. Any overwritten value that
+            // was read is ordered after the claim that preceded it, so the fence guarantees the claim is seen here.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const auto claimedIndex = buffer->ClaimIndex.load(std::memory_order_relaxed);
+            const auto validIndex = claimedIndex > Detail::TraceBufferSize ? claimedIndex - Detail::TraceBufferSize : 0;
+            const auto skip = std::min<size_t>(validIndex > beginIndex ? validIndex - beginIndex : 0, events.size());
+
+            for (auto it = events.begin() + skip; it != events.end(); it++)
+            {
+                if (it->Func == nullptr || it->BeginNs < traceStartNs)
+                    continue;
+
+                out << (first ? "\n" : ",\n");
+                first = false;
+                out << "{\"name\":";
+                WriteJsonString(out, it->Func->GetName());
+                out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->ThreadIndex;
+                out << ",\"ts\":" << (it->BeginNs - traceStartNs) / 1000.0;
+                out << ",\"dur\":" << (it->EndNs - it->BeginNs) / 1000.0 << "}";
+            }
+        }
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+        return !out.fail();
+    }
+
 } // namespace OpenRCT2::Profiling
@@ -24,6 +24,12 @@ namespace OpenRCT2::Profiling
     void Disable();
     bool IsEnabled();
 
+    // Trace mode records the begin and end time of each profiled call into per thread ring buffers without locking,
+    // independent of the statistics collected while the profiler is enabled.
+    void StartTrace();
+    void StopTrace();
+    bool IsTracing();
+
     struct Function
     {
         virtual ~Function() = default;
@@ -53,12 +59,52 @@ namespace OpenRCT2::Profiling
         virtual std::vector<Function*> GetChildren() const = 0;
     };
 
+    /**
+     * A named event count reported alongside the profiled functions, such as cache hits and misses.
+     * Counters must have static storage duration, they only count while the profiler is enabled.
+     */
+    class Counter
+    {
+    private:
+        const char* _name;
+        std::atomic<uint64_t> _value{};
+
+    public:
+        explicit Counter(const char* name);
+        Counter(const Counter&) = delete;
+        Counter& operator=(const Counter&) = delete;
+
+        const char* GetName() const noexcept
+        {
+            return _name;
+        }
+
+        uint64_t GetValue() const noexcept
+        {
+            return _value.load(std::memory_order_relaxed);
+        }
+
+        void Increment() noexcept
+        {
+            if (IsEnabled())
+            {
+                _value.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void Reset() noexcept
+        {
+            _value.store(0, std::memory_order_relaxed);
+        }
+    };
+
     namespace Detail
     {
         static constexpr auto MaxSamplesSize = 1024;
         static constexpr auto MaxNameSize = 250;
 
         std::vector<Function*>& GetRegistry();
+        std::vector<Counter*>& GetCounterRegistry();
 
         struct FunctionInternal : Function
         {
@@ -157,25 +203,40 @@ namespace OpenRCT2::Profiling
         void FunctionEnter(Function& func);
         void FunctionExit(Function& func);
 
+        // Nanoseconds of the steady clock used for trace events.
+        int64_t TraceNow();
+        void TraceFunction(const Function& func, int64_t beginNs);
+
     } // namespace Detail
 
     template<typename T> class ScopedProfiling
     {
         bool _enabled;
+        bool _tracing;
+        int64_t _traceBeginNs{};
         T& _func;
 
     public:
         ScopedProfiling(T& func)
             : _enabled{ IsEnabled() }
+            , _tracing{ IsTracing() }
             , _func(func)
         {
             if (_enabled)
             {
                 Detail::FunctionEnter(_func);
             }
+            if (_tracing)
+            {
+                _traceBeginNs = Detail::TraceNow();
+            }
         }
         ~ScopedProfiling()
         {
+            if (_tracing)
+            {
+                Detail::TraceFunction(_func, _traceBeginNs);
+            }
             if (!_enabled)
                 return;
             Detail::FunctionExit(_func);
@@ -188,6 +249,13 @@ namespace OpenRCT2::Profiling
     // Returns all functions.
     const std::vector<Function*>& GetData();
 
+    // Returns all counters.
+    const std::vector<Counter*>& GetCounters();
+
     bool ExportCSV(const std::string& filePath);
 
+    // Writes the calls recorded since the trace was started as Chrome trace event JSON, which can be opened in
+    // chrome://tracing or Perfetto. Only the most recent calls of each thread are kept.
+    bool ExportChromeTrace(const std::string& filePath);
+
 } // namespace OpenRCT2::Profiling
@@ -1508,9 +1508,10 @@ namespace RCT1
 
             std::vector<TileElement> tileElements;
             const auto maxSize = _s4.MapSize == 0 ? Limits::MaxMapSize : _s4.MapSize;
-            for (TileCoordsXY coords = { 0, 0 }; coords.y < MAXIMUM_MAP_SIZE_TECHNICAL; coords.y++)
+            const auto& mapSize = GetGameState().MapSize;
+            for (TileCoordsXY coords = { 0, 0 }; coords.y < mapSize.y; coords.y++)
             {
-                for (coords.x = 0; coords.x < MAXIMUM_MAP_SIZE_TECHNICAL; coords.x++)
+                for (coords.x = 0; coords.x < mapSize.x; coords.x++)
                 {
                     auto tileAdded = false;
                     if (coords.x < maxSize && coords.y < maxSize)
@@ -1779,9 +1779,10 @@ namespace RCT2
             bool nextElementInvisible = false;
             bool restOfTileInvisible = false;
             const auto maxSize = std::min(Limits::MaxMapSize, _s6.MapSize);
-            for (TileCoordsXY coords = { 0, 0 }; coords.y < MAXIMUM_MAP_SIZE_TECHNICAL; coords.y++)
+            const auto& mapSize = GetGameState().MapSize;
+            for (TileCoordsXY coords = { 0, 0 }; coords.y < mapSize.y; coords.y++)
             {
-                for (coords.x = 0; coords.x < MAXIMUM_MAP_SIZE_TECHNICAL; coords.x++)
+                for (coords.x = 0; coords.x < mapSize.x; coords.x++)
                 {
                     nextElementInvisible = false;
                     restOfTileInvisible = false;
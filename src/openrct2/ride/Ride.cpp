@@ -5700,7 +5700,7 @@ void RideClearLeftoverEntrances(const Ride& ride)
                 if (entrance->GetRideIndex() != ride.id)
                     continue;
 
-                TileElementRemove(entrance->as<TileElement>());
+                TileElementRemove(tilePos.ToCoordsXY(), entrance->as<TileElement>());
             }
         }
     }
@@ -1589,7 +1589,7 @@ void Ride::ValidateStations()
                 FootpathRemoveEdgesAt(location, tileElement);
                 FootpathUpdateQueueChains();
                 MapInvalidateTileFull(location);
-                TileElementRemove(tileElement);
+                TileElementRemove(location, tileElement);
                 tileElement--;
             }
         } while (!(tileElement++)->IsLastForTile());
@@ -19,14 +19,16 @@ namespace TrainManager
     {
         Entity = nullptr;
 
-        while (iter != end && Entity == nullptr)
+        index = GetEntityListResumeIndex(*list, index, nextId);
+        while (index < list->size() && Entity == nullptr)
         {
-            Entity = GetEntity<Vehicle>(*iter++);
+            Entity = GetEntity<Vehicle>((*list)[index++]);
             if (Entity != nullptr && !Entity->IsHead())
             {
                 Entity = nullptr;
             }
         }
+        nextId = GetEntityListIdAt(*list, index);
         return *this;
     }
 
@@ -11,7 +11,7 @@
 #include "../Identifiers.h"
 
 #include <cstdint>
-#include <list>
+#include <vector>
 
 struct Vehicle;
 
@@ -21,19 +21,21 @@ namespace TrainManager
     class View
     {
     private:
-        const std::list<EntityId>* vec;
+        const std::vector<EntityId>* vec;
 
         class Iterator
         {
         private:
-            std::list<EntityId>::const_iterator iter;
-            std::list<EntityId>::const_iterator end;
+            const std::vector<EntityId>* list;
+            size_t index;
+            EntityId nextId;
             Vehicle* Entity = nullptr;
 
         public:
-            Iterator(std::list<EntityId>::const_iterator _iter, std::list<EntityId>::const_iterator _end)
-                : iter(_iter)
-                , end(_end)
+            Iterator(const std::vector<EntityId>& _list, size_t _index)
+                : list(&_list)
+                , index(_index)
+                , nextId(_index < _list.size() ? _list[_index] : EntityId::GetNull())
             {
                 ++(*this);
             }
@@ -70,11 +72,11 @@ namespace TrainManager
 
         Iterator begin()
         {
-            return Iterator(std::cbegin(*vec), std::cend(*vec));
+            return Iterator(*vec, 0);
         }
         Iterator end()
         {
-            return Iterator(std::cend(*vec), std::cend(*vec));
+            return Iterator(*vec, vec->size());
         }
     };
 } // namespace TrainManager
@@ -283,7 +283,8 @@ void ScenarioAutosaveCheck()
             break;
     }
 
-    if (shouldSave)
+    // Postpone the autosave until the previous one has been written
+    if (shouldSave && !GameAutosaveIsPending())
     {
         gLastAutoSaveUpdate = AUTOSAVE_PAUSE;
         GameAutosave();
@@ -28,7 +28,8 @@ using random_engine_t = Random::RCT2::Engine;
 namespace OpenRCT2
 {
     struct GameState_t;
-}
+    class MemoryStream;
+} // namespace OpenRCT2
 
 enum
 {
@@ -180,6 +181,13 @@ uint32_t ScenarioRandMax(uint32_t max);
 
 ResultWithMessage ScenarioPrepareForSave(OpenRCT2::GameState_t& gameState);
 int32_t ScenarioSave(OpenRCT2::GameState_t& gameState, u8string_view path, int32_t flags);
+
+/**
+ * Serialises the game state into memory without compressing it. The snapshot does not refer to the game state, so
+ * ScenarioWriteSnapshot can compress and write it on another thread while the game continues.
+ */
+bool ScenarioSaveSnapshot(OpenRCT2::GameState_t& gameState, OpenRCT2::MemoryStream& snapshot, int32_t flags);
+bool ScenarioWriteSnapshot(OpenRCT2::MemoryStream& snapshot, u8string_view path);
 void ScenarioFailure(OpenRCT2::GameState_t& gameState);
 void ScenarioSuccess(OpenRCT2::GameState_t& gameState);
 void ScenarioSuccessSubmitName(OpenRCT2::GameState_t& gameState, const char* name);
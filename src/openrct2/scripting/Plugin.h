@@ -12,7 +12,10 @@
 #ifdef ENABLE_SCRIPTING
 
 #    include "Duktape.hpp"
+#    include "HookEngine.h"
 
+#    include <algorithm>
+#    include <array>
 #    include <memory>
 #    include <string>
 #    include <string_view>
@@ -52,6 +55,38 @@ namespace OpenRCT2::Scripting
         DukValue Main;
     };
 
+    struct PluginCallStats
+    {
+        uint32_t CallCount{};
+        double TotalTimeUs{};
+        double MaxTimeUs{};
+
+        void Add(double timeUs)
+        {
+            CallCount++;
+            TotalTimeUs += timeUs;
+            MaxTimeUs = std::max(MaxTimeUs, timeUs);
+        }
+    };
+
+    /**
+     * Time spent executing the code of a plugin. Time spent in other plugins that are called from it, e.g. through
+     * action hooks when it executes a game action, is not included.
+     */
+    struct PluginTimings
+    {
+        PluginCallStats Total;
+        PluginCallStats Intervals;
+        std::array<PluginCallStats, NUM_HOOK_TYPES> Hooks;
+
+        // Time used since the last script engine tick, checked against the tick budget.
+        double TickTimeUs{};
+        bool IsOverBudget{};
+        uint32_t OverrunCount{};
+        uint32_t DeferredCount{};
+        uint32_t LastWarningTimestamp{};
+    };
+
     class Plugin
     {
     private:
@@ -62,6 +97,7 @@ namespace OpenRCT2::Scripting
         bool _hasLoaded{};
         bool _hasStarted{};
         bool _isStopping{};
+        PluginTimings _timings{};
 
     public:
         std::string_view GetPath() const
@@ -99,6 +135,16 @@ namespace OpenRCT2::Scripting
             return _hasLoaded;
         }
 
+        PluginTimings& GetTimings()
+        {
+            return _timings;
+        }
+
+        const PluginTimings& GetTimings() const
+        {
+            return _timings;
+        }
+
         int32_t GetTargetAPIVersion() const;
 
         Plugin() = default;
@@ -21,6 +21,7 @@
 #    include "../core/File.h"
 #    include "../core/FileScanner.h"
 #    include "../core/Path.hpp"
+#    include "../core/String.hpp"
 #    include "../interface/InteractiveConsole.h"
 #    include "../platform/Platform.h"
 #    include "Duktape.hpp"
@@ -54,10 +55,12 @@
 #    include "bindings/world/ScTile.hpp"
 #    include "bindings/world/ScTileElement.hpp"
 
+#    include <chrono>
 #    include <iostream>
 #    include <memory>
 #    include <stdexcept>
 #    include <string>
+#    include <utility>
 
 using namespace OpenRCT2;
 using namespace OpenRCT2::Scripting;
@@ -908,6 +911,7 @@ void ScriptEngine::Tick()
     PROFILED_FUNCTION();
 
     CheckAndStartPlugins();
+    UpdatePluginTimeBudgets();
     UpdateIntervals();
     UpdateSockets();
     ProcessREPL();
@@ -979,6 +983,7 @@ DukValue ScriptEngine::ExecutePluginCall(
     bool isGameStateMutable)
 {
     DukStackFrame frame(_context);
+    _lastPluginCallTimeUs = 0;
     if (func.is_function() && plugin->HasStarted())
     {
         ScriptExecutionInfo::PluginScope scope(_execInfo, plugin, isGameStateMutable);
@@ -988,7 +993,19 @@ DukValue ScriptEngine::ExecutePluginCall(
         {
             arg.push();
         }
+
+        auto outerNestedCallTimeUs = std::exchange(_nestedCallTimeUs, 0.0);
+        auto startTime = std::chrono::steady_clock::now();
         auto result = duk_pcall_method(_context, static_cast<duk_idx_t>(args.size()));
+        auto callTimeUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+
+        // Calls into other plugins made by this one are accounted to those plugins
+        _lastPluginCallTimeUs = std::max(callTimeUs - _nestedCallTimeUs, 0.0);
+        _nestedCallTimeUs = outerNestedCallTimeUs + callTimeUs;
+        auto& timings = plugin->GetTimings();
+        timings.Total.Add(_lastPluginCallTimeUs);
+        timings.TickTimeUs += _lastPluginCallTimeUs;
+
         if (result == DUK_EXEC_SUCCESS)
         {
             return DukValue::take_from_stack(_context);
@@ -1001,6 +1018,50 @@ DukValue ScriptEngine::ExecutePluginCall(
     return DukValue();
 }
 
+void ScriptEngine::ResetPluginTimings()
+{
+    for (auto& plugin : _plugins)
+    {
+        auto& timings = plugin->GetTimings();
+        timings = {};
+    }
+}
+
+void ScriptEngine::UpdatePluginTimeBudgets()
+{
+    const auto budgetUs = gConfigPlugin.TickBudget * 1000.0;
+    const auto timestamp = Platform::GetTicks();
+    for (auto& plugin : _plugins)
+    {
+        auto& timings = plugin->GetTimings();
+        timings.IsOverBudget = budgetUs > 0 && timings.TickTimeUs > budgetUs;
+        if (timings.IsOverBudget)
+        {
+            timings.OverrunCount++;
+
+            // Warn at most every 10 seconds so a slow plugin does not flood the console
+            if (timings.LastWarningTimestamp == 0 || timestamp - timings.LastWarningTimestamp >= 10000)
+            {
+                timings.LastWarningTimestamp = timestamp;
+                LogPluginInfo(
+                    plugin,
+                    String::StdFormat(
+                        "Took %.2f ms in the last tick which is over the budget of %.2f ms (%u times so far)",
+                        timings.TickTimeUs / 1000.0, gConfigPlugin.TickBudget, timings.OverrunCount));
+            }
+        }
+        timings.TickTimeUs = 0;
+    }
+}
+
+bool ScriptEngine::ShouldDeferPlugin(const Plugin& plugin) const
+{
+    // Intervals of plugins that went over the budget wait for a later tick, hooks can not be deferred
+    const auto budgetUs = gConfigPlugin.TickBudget * 1000.0;
+    const auto& timings = plugin.GetTimings();
+    return budgetUs > 0 && (timings.IsOverBudget || timings.TickTimeUs > budgetUs);
+}
+
 void ScriptEngine::LogPluginInfo(std::string_view message)
 {
     auto plugin = _execInfo.GetCurrentPlugin();
@@ -1684,7 +1745,16 @@ void ScriptEngine::UpdateIntervals()
             continue;
         }
 
-        ExecutePluginCall(interval.Owner, interval.Callback, {}, false);
+        // The interval can be removed by the call, so keep the owner alive
+        auto owner = interval.Owner;
+        if (ShouldDeferPlugin(*owner))
+        {
+            owner->GetTimings().DeferredCount++;
+            continue;
+        }
+
+        ExecutePluginCall(owner, interval.Callback, {}, false);
+        owner->GetTimings().Intervals.Add(_lastPluginCallTimeUs);
 
         interval.LastTimestamp = timestamp;
         if (!interval.Repeat)
@@ -47,7 +47,7 @@ namespace OpenRCT2
 
 namespace OpenRCT2::Scripting
 {
-    static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 82;
+    static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 85;
 
     // Versions marking breaking changes.
     static constexpr int32_t API_VERSION_33_PEEP_DEPRECATION = 33;
@@ -156,6 +156,10 @@ namespace OpenRCT2::Scripting
         DukValue _sharedStorage;
         DukValue _parkStorage;
 
+        // Time of the plugin calls that are in progress spent in the calls nested in them.
+        double _nestedCallTimeUs{};
+        double _lastPluginCallTimeUs{};
+
         uint32_t _lastIntervalTimestamp{};
         std::map<IntervalHandle, ScriptInterval> _intervals;
         IntervalHandle _nextIntervalHandle = 1;
@@ -238,6 +242,15 @@ namespace OpenRCT2::Scripting
             std::shared_ptr<Plugin> plugin, const DukValue& func, const DukValue& thisValue, const std::vector<DukValue>& args,
             bool isGameStateMutable);
 
+        /**
+         * Gets the time spent in the code of the plugin by the last call of ExecutePluginCall, in microseconds.
+         */
+        double GetLastPluginCallTime() const
+        {
+            return _lastPluginCallTimeUs;
+        }
+        void ResetPluginTimings();
+
         void LogPluginInfo(std::string_view message);
         void LogPluginInfo(const std::shared_ptr<Plugin>& plugin, std::string_view message);
 
@@ -296,6 +309,8 @@ namespace OpenRCT2::Scripting
         void LoadSharedStorage();
 
         IntervalHandle AllocateHandle();
+        void UpdatePluginTimeBudgets();
+        bool ShouldDeferPlugin(const Plugin& plugin) const;
         void UpdateIntervals();
         void RemoveIntervals(const std::shared_ptr<Plugin>& plugin);
 
@@ -11,8 +11,11 @@
 
 #ifdef ENABLE_SCRIPTING
 
+#    include "../../../Context.h"
 #    include "../../../profiling/Profiling.h"
 #    include "../../Duktape.hpp"
+#    include "../../HookEngine.h"
+#    include "../../ScriptEngine.h"
 
 namespace OpenRCT2::Scripting
 {
@@ -50,6 +53,68 @@ namespace OpenRCT2::Scripting
             return DukValue::take_from_stack(_ctx);
         }
 
+        DukValue getCounters()
+        {
+            const auto& counters = OpenRCT2::Profiling::GetCounters();
+            duk_push_array(_ctx);
+            duk_uarridx_t index = 0;
+            for (const auto* counter : counters)
+            {
+                DukObject obj(_ctx);
+                obj.Set("name", counter->GetName());
+                obj.Set("value", counter->GetValue());
+                obj.Take().push();
+                duk_put_prop_index(_ctx, /* duk stack index */ -2, index);
+                index++;
+            }
+            return DukValue::take_from_stack(_ctx);
+        }
+
+        DukValue getPluginData()
+        {
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            duk_push_array(_ctx);
+            duk_uarridx_t index = 0;
+            for (const auto& plugin : scriptEngine.GetPlugins())
+            {
+                const auto& timings = plugin->GetTimings();
+                DukObject obj(_ctx);
+                obj.Set("name", plugin->GetMetadata().Name);
+                SetCallStats(obj, timings.Total);
+                obj.Set("overrunCount", timings.OverrunCount);
+                obj.Set("deferredCount", timings.DeferredCount);
+
+                DukObject intervals(_ctx);
+                SetCallStats(intervals, timings.Intervals);
+                obj.Set("intervals", intervals.Take());
+
+                DukObject hooks(_ctx);
+                for (size_t i = 0; i < NUM_HOOK_TYPES; i++)
+                {
+                    if (timings.Hooks[i].CallCount != 0)
+                    {
+                        DukObject hook(_ctx);
+                        SetCallStats(hook, timings.Hooks[i]);
+                        auto hookName = std::string(GetHookTypeName(static_cast<HOOK_TYPE>(i)));
+                        hooks.Set(hookName.c_str(), hook.Take());
+                    }
+                }
+                obj.Set("hooks", hooks.Take());
+
+                obj.Take().push();
+                duk_put_prop_index(_ctx, /* duk stack index */ -2, index);
+                index++;
+            }
+            return DukValue::take_from_stack(_ctx);
+        }
+
+        static void SetCallStats(DukObject& obj, const PluginCallStats& stats)
+        {
+            obj.Set("callCount", stats.CallCount);
+            obj.Set("totalTime", stats.TotalTimeUs);
+            obj.Set("maxTime", stats.MaxTimeUs);
+        }
+
         DukValue GetFunctionIndexArray(
             const std::vector<OpenRCT2::Profiling::Function*>& all, const std::vector<OpenRCT2::Profiling::Function*>& items)
         {
@@ -82,6 +147,7 @@ namespace OpenRCT2::Scripting
         void reset()
         {
             OpenRCT2::Profiling::ResetData();
+            GetContext()->GetScriptEngine().ResetPluginTimings();
         }
 
         bool enabled_get() const
@@ -93,6 +159,8 @@ namespace OpenRCT2::Scripting
         static void Register(duk_context* ctx)
         {
             dukglue_register_method(ctx, &ScProfiler::getData, "getData");
+            dukglue_register_method(ctx, &ScProfiler::getCounters, "getCounters");
+            dukglue_register_method(ctx, &ScProfiler::getPluginData, "getPluginData");
             dukglue_register_method(ctx, &ScProfiler::start, "start");
             dukglue_register_method(ctx, &ScProfiler::stop, "stop");
             dukglue_register_method(ctx, &ScProfiler::reset, "reset");
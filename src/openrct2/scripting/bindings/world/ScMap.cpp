@@ -35,6 +35,9 @@
 #    include "../ride/ScTrackIterator.h"
 #    include "../world/ScTile.hpp"
 
+#    include <algorithm>
+#    include <optional>
+
 namespace OpenRCT2::Scripting
 {
     ScMap::ScMap(duk_context* ctx)
@@ -230,6 +233,202 @@ namespace OpenRCT2::Scripting
         return result;
     }
 
+    enum class EntityQueryTarget : uint8_t
+    {
+        Entity,
+        Peep,
+        Guest,
+        Vehicle,
+    };
+
+    struct EntityQueryField
+    {
+        const char* Name;
+        EntityQueryTarget Target;
+        int32_t (*Get)(const EntityBase& entity);
+    };
+
+    // Fields that can be requested by ScMap::queryEntities, the target tells which entity types have the field.
+    static constexpr EntityQueryField EntityQueryFields[] = {
+        { "id", EntityQueryTarget::Entity, [](const EntityBase& e) -> int32_t { return e.Id.ToUnderlying(); } },
+        { "x", EntityQueryTarget::Entity, [](const EntityBase& e) -> int32_t { return e.x; } },
+        { "y", EntityQueryTarget::Entity, [](const EntityBase& e) -> int32_t { return e.y; } },
+        { "z", EntityQueryTarget::Entity, [](const EntityBase& e) -> int32_t { return e.z; } },
+        { "energy", EntityQueryTarget::Peep,
+          [](const EntityBase& e) -> int32_t { return static_cast<const Peep&>(e).Energy; } },
+        { "energyTarget", EntityQueryTarget::Peep,
+          [](const EntityBase& e) -> int32_t { return static_cast<const Peep&>(e).EnergyTarget; } },
+        { "happiness", EntityQueryTarget::Guest,
+          [](const EntityBase& e) -> int32_t { return static_cast<const Guest&>(e).Happiness; } },
+        { "happinessTarget", EntityQueryTarget::Guest,
+          [](const EntityBase& e) -> int32_t { return static_cast<const Guest&>(e).HappinessTarget; } },
+        { "nausea", EntityQueryTarget::Guest,
+          [](const EntityBase& e) -> int32_t { return static_cast<const Guest&>(e).Nausea; } },
+        { "hunger", EntityQueryTarget::Guest,
+          [](const EntityBase& e) -> int32_t { return static_cast<const Guest&>(e).Hunger; } },
+        { "thirst", EntityQueryTarget::Guest,
+          [](const EntityBase& e) -> int32_t { return static_cast<const Guest&>(e).Thirst; } },
+        { "toilet", EntityQueryTarget::Guest,
+          [](const EntityBase& e) -> int32_t { return static_cast<const Guest&>(e).Toilet; } },
+        { "cash", EntityQueryTarget::Guest,
+          [](const EntityBase& e) -> int32_t { return static_cast<int32_t>(static_cast<const Guest&>(e).CashInPocket); } },
+        { "isInPark", EntityQueryTarget::Guest,
+          [](const EntityBase& e) -> int32_t { return !static_cast<const Guest&>(e).OutsideOfPark; } },
+        { "ride", EntityQueryTarget::Vehicle,
+          [](const EntityBase& e) -> int32_t { return static_cast<const Vehicle&>(e).ride.ToUnderlying(); } },
+        { "velocity", EntityQueryTarget::Vehicle,
+          [](const EntityBase& e) -> int32_t { return static_cast<const Vehicle&>(e).velocity; } },
+    };
+
+    struct EntityQueryArea
+    {
+        MapRange Range;
+        std::optional<CoordsXY> Centre;
+        int64_t RadiusSquared{};
+
+        bool Contains(const EntityBase& entity) const
+        {
+            if (entity.x < Range.GetLeft() || entity.x > Range.GetRight() || entity.y < Range.GetTop()
+                || entity.y > Range.GetBottom())
+                return false;
+            if (Centre.has_value())
+            {
+                int64_t dx = entity.x - Centre->x;
+                int64_t dy = entity.y - Centre->y;
+                return dx * dx + dy * dy <= RadiusSquared;
+            }
+            return true;
+        }
+    };
+
+    template<typename T> static void QueryEntities(std::vector<const EntityBase*>& result, const EntityQueryArea* area)
+    {
+        if (area == nullptr)
+        {
+            for (auto entity : EntityList<T>())
+            {
+                result.push_back(entity);
+            }
+            return;
+        }
+
+        // Only look at the tiles covering the area using the entity tile index
+        auto mapSize = GetMapSizeMaxXY();
+        auto left = std::max(area->Range.GetLeft(), 0);
+        auto top = std::max(area->Range.GetTop(), 0);
+        auto right = std::min(area->Range.GetRight(), mapSize.x);
+        auto bottom = std::min(area->Range.GetBottom(), mapSize.y);
+        for (int32_t y = Floor2(top, COORDS_XY_STEP); y <= bottom; y += COORDS_XY_STEP)
+        {
+            for (int32_t x = Floor2(left, COORDS_XY_STEP); x <= right; x += COORDS_XY_STEP)
+            {
+                for (auto entity : EntityTileList<T>({ x, y }))
+                {
+                    if (area->Contains(*entity))
+                        result.push_back(entity);
+                }
+            }
+        }
+    }
+
+    DukValue ScMap::queryEntities(
+        const std::string& type, const std::vector<std::string>& fields, const DukValue& options) const
+    {
+        std::optional<EntityQueryArea> area;
+        if (options.type() == DukValue::Type::OBJECT)
+        {
+            auto dukRange = options["range"];
+            auto dukCentre = options["centre"];
+            if (dukRange.type() == DukValue::Type::OBJECT)
+            {
+                area = EntityQueryArea{ FromDuk<MapRange>(dukRange).Normalise(), std::nullopt, 0 };
+            }
+            else if (dukCentre.type() == DukValue::Type::OBJECT)
+            {
+                auto centre = FromDuk<CoordsXY>(dukCentre);
+                auto radius = std::max(AsOrDefault(options["radius"], 0), 0);
+                area = EntityQueryArea{ MapRange(centre.x - radius, centre.y - radius, centre.x + radius, centre.y + radius),
+                                        centre, static_cast<int64_t>(radius) * radius };
+            }
+        }
+        const auto* queryArea = area.has_value() ? &area.value() : nullptr;
+
+        std::vector<const EntityBase*> entities;
+        auto target = EntityQueryTarget::Entity;
+        if (type == "balloon")
+        {
+            QueryEntities<Balloon>(entities, queryArea);
+        }
+        else if (type == "car")
+        {
+            target = EntityQueryTarget::Vehicle;
+            QueryEntities<Vehicle>(entities, queryArea);
+        }
+        else if (type == "litter")
+        {
+            QueryEntities<Litter>(entities, queryArea);
+        }
+        else if (type == "duck")
+        {
+            QueryEntities<Duck>(entities, queryArea);
+        }
+        else if (type == "peep")
+        {
+            target = EntityQueryTarget::Peep;
+            QueryEntities<Guest>(entities, queryArea);
+            QueryEntities<Staff>(entities, queryArea);
+        }
+        else if (type == "guest")
+        {
+            target = EntityQueryTarget::Guest;
+            QueryEntities<Guest>(entities, queryArea);
+        }
+        else if (type == "staff")
+        {
+            target = EntityQueryTarget::Peep;
+            QueryEntities<Staff>(entities, queryArea);
+        }
+        else
+        {
+            duk_error(_context, DUK_ERR_ERROR, "Invalid entity type.");
+        }
+
+        std::vector<const EntityQueryField*> queryFields;
+        for (const auto& name : fields)
+        {
+            auto it = std::find_if(std::begin(EntityQueryFields), std::end(EntityQueryFields), [&name](const auto& field) {
+                return name == field.Name;
+            });
+            // Guests are peeps, so they also have the peep fields
+            if (it == std::end(EntityQueryFields)
+                || (it->Target != EntityQueryTarget::Entity && it->Target != target
+                    && !(it->Target == EntityQueryTarget::Peep && target == EntityQueryTarget::Guest)))
+            {
+                duk_error(_context, DUK_ERR_ERROR, "Invalid field for entity type %s: %s", type.c_str(), name.c_str());
+            }
+            queryFields.push_back(&*it);
+        }
+
+        // Each field is returned as an Int32Array with an element per entity
+        auto count = entities.size();
+        auto bufferSize = count * sizeof(int32_t);
+        duk_push_object(_context);
+        duk_push_uint(_context, static_cast<duk_uint_t>(count));
+        duk_put_prop_string(_context, -2, "count");
+        for (size_t i = 0; i < queryFields.size(); i++)
+        {
+            auto* data = static_cast<int32_t*>(duk_push_fixed_buffer(_context, bufferSize));
+            for (size_t j = 0; j < count; j++)
+            {
+                data[j] = queryFields[i]->Get(*entities[j]);
+            }
+            duk_push_buffer_object(_context, -1, 0, bufferSize, DUK_BUFOBJ_INT32ARRAY);
+            duk_put_prop_string(_context, -3, fields[i].c_str());
+            duk_pop(_context);
+        }
+        return DukValue::take_from_stack(_context);
+    }
+
     template<typename TEntityType, typename TScriptType>
     DukValue createEntityType(duk_context* ctx, const DukValue& initializer)
     {
@@ -331,6 +530,7 @@ namespace OpenRCT2::Scripting
         dukglue_register_method(ctx, &ScMap::getEntity, "getEntity");
         dukglue_register_method(ctx, &ScMap::getAllEntities, "getAllEntities");
         dukglue_register_method(ctx, &ScMap::getAllEntitiesOnTile, "getAllEntitiesOnTile");
+        dukglue_register_method(ctx, &ScMap::queryEntities, "queryEntities");
         dukglue_register_method(ctx, &ScMap::createEntity, "createEntity");
         dukglue_register_method(ctx, &ScMap::getTrackIterator, "getTrackIterator");
     }
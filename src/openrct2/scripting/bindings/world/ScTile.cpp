@@ -17,8 +17,10 @@
 #    include "../../../entity/EntityRegistry.h"
 #    include "../../../ride/Track.h"
 #    include "../../../world/Footpath.h"
+#    include "../../../world/RidePresence.h"
 #    include "../../../world/Scenery.h"
 #    include "../../../world/Surface.h"
+#    include "../../../world/TileSummary.h"
 #    include "../../Duktape.hpp"
 #    include "../../ScriptEngine.h"
 #    include "ScTileElement.hpp"
@@ -126,6 +128,8 @@ namespace OpenRCT2::Scripting
                 }
             }
             MapInvalidateTileFull(_coords);
+            RidePresenceMarkTile(TileCoordsXY(_coords));
+            TileSummaryInvalidateTile(_coords);
         }
     }
 
@@ -178,6 +182,7 @@ namespace OpenRCT2::Scripting
                 }
                 first[origNumElements].SetLastForTile(true);
                 MapInvalidateTileFull(_coords);
+                TileSummaryInvalidateTile(_coords);
                 result = std::make_shared<ScTileElement>(_coords, &first[index]);
             }
         }
@@ -195,7 +200,7 @@ namespace OpenRCT2::Scripting
         auto first = GetFirstElement();
         if (index < GetNumElements(first))
         {
-            TileElementRemove(&first[index]);
+            TileElementRemove(_coords, &first[index]);
             MapInvalidateTileFull(_coords);
         }
     }
@@ -19,8 +19,10 @@
 #    include "../../../ride/RideData.h"
 #    include "../../../ride/Track.h"
 #    include "../../../world/Footpath.h"
+#    include "../../../world/RidePresence.h"
 #    include "../../../world/Scenery.h"
 #    include "../../../world/Surface.h"
+#    include "../../../world/TileSummary.h"
 #    include "../../Duktape.hpp"
 #    include "../../ScriptEngine.h"
 
@@ -68,7 +70,10 @@ namespace OpenRCT2::Scripting
         else if (value == "footpath")
             _element->SetType(TileElementType::Path);
         else if (value == "track")
+        {
             _element->SetType(TileElementType::Track);
+            RidePresenceMarkTile(TileCoordsXY(_coords));
+        }
         else if (value == "small_scenery")
             _element->SetType(TileElementType::SmallScenery);
         else if (value == "entrance")
@@ -2050,6 +2055,7 @@ namespace OpenRCT2::Scripting
     void ScTileElement::Invalidate()
     {
         MapInvalidateTileFull(_coords);
+        TileSummaryInvalidateTile(_coords);
     }
 
     void ScTileElement::Register(duk_context* ctx)
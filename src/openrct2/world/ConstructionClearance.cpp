@@ -53,7 +53,7 @@ static int32_t MapPlaceClearFunc(
 
     MapInvalidateTile({ coords, (*tile_element)->GetBaseZ(), (*tile_element)->GetClearanceZ() });
 
-    TileElementRemove(*tile_element);
+    TileElementRemove(coords, *tile_element);
 
     (*tile_element)--;
     return 0;
@@ -23,6 +23,7 @@
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
 #include "../interface/Cursors.h"
+#include "../interface/Viewport.h"
 #include "../interface/Window.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
@@ -32,6 +33,7 @@
 #include "../object/ObjectManager.h"
 #include "../object/SmallSceneryEntry.h"
 #include "../object/TerrainSurfaceObject.h"
+#include "../paint/PaintCache.h"
 #include "../profiling/Profiling.h"
 #include "../ride/RideConstruction.h"
 #include "../ride/RideData.h"
@@ -47,10 +49,12 @@
 #include "Footpath.h"
 #include "MapAnimation.h"
 #include "Park.h"
+#include "RidePresence.h"
 #include "Scenery.h"
 #include "Surface.h"
 #include "TileElementsView.h"
 #include "TileInspector.h"
+#include "TileSummary.h"
 #include "Wall.h"
 
 #include <algorithm>
@@ -130,6 +134,8 @@ void UnstashMap()
     GetGameState().MapSize = _mapSizeStash;
     gCurrentRotation = _currentRotationStash;
     _tileElementsInUse = _tileElementsInUseStash;
+    RidePresenceInvalidateAll();
+    TileSummaryInvalidateAll();
 }
 
 CoordsXY GetMapSizeUnits()
@@ -153,11 +159,61 @@ const std::vector<TileElement>& GetTileElements()
     return _tileElements;
 }
 
-void SetTileElements(std::vector<TileElement>&& tileElements)
+static TileCoordsXY GetTileStorageSize(const TileCoordsXY& mapSize)
+{
+    return { std::clamp(mapSize.x, 0, MAXIMUM_MAP_SIZE_TECHNICAL), std::clamp(mapSize.y, 0, MAXIMUM_MAP_SIZE_TECHNICAL) };
+}
+
+static void SetTileElementsForStorageSize(std::vector<TileElement>&& tileElements, const TileCoordsXY& storageSize)
 {
     _tileElements = std::move(tileElements);
-    _tileIndex = TilePointerIndex<TileElement>(MAXIMUM_MAP_SIZE_TECHNICAL, _tileElements.data(), _tileElements.size());
+    _tileIndex = TilePointerIndex<TileElement>(storageSize, _tileElements.data(), _tileElements.size());
     _tileElementsInUse = _tileElements.size();
+    RidePresenceInvalidateAll();
+    TileSummaryInvalidateAll();
+}
+
+static TileElement GetDefaultSurfaceElement();
+
+void SetTileElements(std::vector<TileElement>&& tileElements)
+{
+    SetTileElementsForStorageSize(std::move(tileElements), GetTileStorageSize(GetGameState().MapSize));
+}
+
+void SetTileElements(std::vector<TileElement>&& tileElements, const TileCoordsXY& layoutSize)
+{
+    const auto storageSize = GetTileStorageSize(GetGameState().MapSize);
+    if (layoutSize == storageSize)
+    {
+        SetTileElementsForStorageSize(std::move(tileElements), storageSize);
+        return;
+    }
+
+    // Copy only the tiles that are within the map, anything outside of it is not kept in memory.
+    auto layoutIndex = TilePointerIndex<TileElement>(layoutSize, tileElements.data(), tileElements.size());
+
+    std::vector<TileElement> newElements;
+    newElements.reserve(std::max(MIN_TILE_ELEMENTS, tileElements.size()));
+    for (int32_t y = 0; y < storageSize.y; y++)
+    {
+        for (int32_t x = 0; x < storageSize.x; x++)
+        {
+            const TileCoordsXY coords{ x, y };
+            if (!layoutIndex.IsInRange(coords))
+            {
+                newElements.push_back(GetDefaultSurfaceElement());
+                continue;
+            }
+
+            const auto* element = layoutIndex.GetFirstElementAt(coords);
+            do
+            {
+                newElements.push_back(*element);
+            } while (!(element++)->IsLastForTile());
+        }
+    }
+
+    SetTileElementsForStorageSize(std::move(newElements), storageSize);
 }
 
 static TileElement GetDefaultSurfaceElement()
@@ -179,6 +235,8 @@ static TileElement GetDefaultSurfaceElement()
 
 std::vector<TileElement> GetReorganisedTileElementsWithoutGhosts()
 {
+    // The park format always stores the full technical map size, tiles that are not kept in memory are
+    // written as default surfaces.
     std::vector<TileElement> newElements;
     newElements.reserve(std::max(MIN_TILE_ELEMENTS, _tileElements.size()));
     for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
@@ -215,15 +273,15 @@ std::vector<TileElement> GetReorganisedTileElementsWithoutGhosts()
     return newElements;
 }
 
-static void ReorganiseTileElements(size_t capacity)
+static void ReorganiseTileElements(size_t capacity, const TileCoordsXY& storageSize)
 {
     ContextSetCurrentCursor(CursorID::ZZZ);
 
     std::vector<TileElement> newElements;
     newElements.reserve(std::max(MIN_TILE_ELEMENTS, capacity));
-    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    for (int32_t y = 0; y < storageSize.y; y++)
     {
-        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        for (int32_t x = 0; x < storageSize.x; x++)
         {
             const auto* element = MapGetFirstElementAt(TileCoordsXY{ x, y });
             if (element == nullptr)
@@ -240,7 +298,12 @@ static void ReorganiseTileElements(size_t capacity)
         }
     }
 
-    SetTileElements(std::move(newElements));
+    SetTileElementsForStorageSize(std::move(newElements), storageSize);
+}
+
+static void ReorganiseTileElements(size_t capacity)
+{
+    ReorganiseTileElements(capacity, _tileIndex.GetMapSize());
 }
 
 void ReorganiseTileElements()
@@ -248,6 +311,15 @@ void ReorganiseTileElements()
     ReorganiseTileElements(_tileElements.size());
 }
 
+void MapResizeTileElements(const TileCoordsXY& mapSize)
+{
+    const auto storageSize = GetTileStorageSize(mapSize);
+    if (storageSize == _tileIndex.GetMapSize())
+        return;
+
+    ReorganiseTileElements(_tileElements.size(), storageSize);
+}
+
 static bool MapCheckFreeElementsAndReorganise(size_t numElementsOnTile, size_t numNewElements)
 {
     // Check hard cap on num in use tiles (this would be the size of _tileElements immediately after a reorg)
@@ -313,14 +385,15 @@ int32_t TileElementIteratorNext(TileElementIterator* it)
         return 1;
     }
 
-    if (it->y < (MAXIMUM_MAP_SIZE_TECHNICAL - 1))
+    const auto& storageSize = _tileIndex.GetMapSize();
+    if (it->y < (storageSize.y - 1))
     {
         it->y++;
         it->element = MapGetFirstElementAt(TileCoordsXY{ it->x, it->y });
         return 1;
     }
 
-    if (it->x < (MAXIMUM_MAP_SIZE_TECHNICAL - 1))
+    if (it->x < (storageSize.x - 1))
     {
         it->y = 0;
         it->x++;
@@ -338,9 +411,7 @@ void TileElementIteratorRestartForTile(TileElementIterator* it)
 
 static bool IsTileLocationValid(const TileCoordsXY& coords)
 {
-    const bool is_x_valid = coords.x < MAXIMUM_MAP_SIZE_TECHNICAL && coords.x >= 0;
-    const bool is_y_valid = coords.y < MAXIMUM_MAP_SIZE_TECHNICAL && coords.y >= 0;
-    return is_x_valid && is_y_valid;
+    return _tileIndex.IsInRange(coords);
 }
 
 TileElement* MapGetFirstElementAt(const TileCoordsXY& tilePos)
@@ -403,12 +474,13 @@ TileElement* MapGetFirstTileElementWithBaseHeightBetween(const TileCoordsXYRange
 
 void MapSetTileElement(const TileCoordsXY& tilePos, TileElement* elements)
 {
-    if (!MapIsLocationValid(tilePos.ToCoordsXY()))
+    if (!IsTileLocationValid(tilePos))
     {
         LOG_ERROR("Trying to access element outside of range");
         return;
     }
     _tileIndex.SetTile(tilePos, elements);
+    TileSummaryInvalidateTile(tilePos);
 }
 
 SurfaceElement* MapGetSurfaceElementAt(const TileCoordsXY& coords)
@@ -456,14 +528,15 @@ BannerElement* MapGetBannerElementAt(const CoordsXYZ& bannerPos, uint8_t positio
  */
 void MapInit(const TileCoordsXY& size)
 {
-    auto numTiles = MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL;
-    SetTileElements(std::vector<TileElement>(numTiles, GetDefaultSurfaceElement()));
-
     auto& gameState = GetGameState();
+    gameState.MapSize = size;
+
+    const auto storageSize = GetTileStorageSize(size);
+    auto numTiles = storageSize.x * storageSize.y;
+    SetTileElementsForStorageSize(std::vector<TileElement>(numTiles, GetDefaultSurfaceElement()), storageSize);
 
     gGrassSceneryTileLoopPosition = 0;
     gWidePathTileLoopPosition = {};
-    gameState.MapSize = size;
     gameState.MapBaseZ = 7;
     MapRemoveOutOfRangeElements();
     MapAnimationAutoCreate();
@@ -529,6 +602,7 @@ void MapStripGhostFlagFromElements()
     {
         element.SetGhost(false);
     }
+    TileSummaryInvalidateAll();
 }
 
 /**
@@ -1017,8 +1091,10 @@ bool MapIsLocationAtEdge(const CoordsXY& loc)
  *
  *  rct2: 0x0068B280
  */
-void TileElementRemove(TileElement* tileElement)
+void TileElementRemove(const CoordsXY& loc, TileElement* tileElement)
 {
+    TileSummaryInvalidateTile(loc);
+
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
@@ -1067,7 +1143,7 @@ void MapRemoveAllRides()
             case TileElementType::Track:
                 FootpathQueueChainReset();
                 FootpathRemoveEdgesAt(TileCoordsXY{ it.x, it.y }.ToCoordsXY(), it.element);
-                TileElementRemove(it.element);
+                TileElementRemove(TileCoordsXY{ it.x, it.y }.ToCoordsXY(), it.element);
                 TileElementIteratorRestartForTile(&it);
                 break;
             default:
@@ -1185,6 +1261,8 @@ TileElement* TileElementInsert(const CoordsXYZ& loc, int32_t occupiedQuadrants,
 
     // Set tile index pointer to point to new element block
     _tileIndex.SetTile(tileLoc, newTileElement);
+    RidePresenceMarkTile(tileLoc);
+    TileSummaryInvalidateTile(tileLoc);
 
     bool isLastForTile = false;
     if (originalTileElement == nullptr)
@@ -1358,9 +1436,10 @@ void MapRemoveOutOfRangeElements()
     bool buildState = gCheatsBuildInPauseMode;
     gCheatsBuildInPauseMode = true;
 
-    for (int32_t y = MAXIMUM_MAP_SIZE_BIG - COORDS_XY_STEP; y >= 0; y -= COORDS_XY_STEP)
+    const auto storageSizeBig = _tileIndex.GetMapSize().ToCoordsXY();
+    for (int32_t y = storageSizeBig.y - COORDS_XY_STEP; y >= 0; y -= COORDS_XY_STEP)
     {
-        for (int32_t x = MAXIMUM_MAP_SIZE_BIG - COORDS_XY_STEP; x >= 0; x -= COORDS_XY_STEP)
+        for (int32_t x = storageSizeBig.x - COORDS_XY_STEP; x >= 0; x -= COORDS_XY_STEP)
         {
             if (x == 0 || y == 0 || x >= mapSizeMax.x || y >= mapSizeMax.y)
             {
@@ -1423,7 +1502,7 @@ static void MapExtendBoundarySurfaceExtendTile(const SurfaceElement& sourceTile,
 void MapExtendBoundarySurfaceY()
 {
     auto y = GetGameState().MapSize.y - 2;
-    for (auto x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+    for (auto x = 0; x < _tileIndex.GetMapSize().x; x++)
     {
         auto existingTileElement = MapGetSurfaceElementAt(TileCoordsXY{ x, y - 1 });
         auto newTileElement = MapGetSurfaceElementAt(TileCoordsXY{ x, y });
@@ -1443,7 +1522,7 @@ void MapExtendBoundarySurfaceY()
 void MapExtendBoundarySurfaceX()
 {
     auto x = GetGameState().MapSize.x - 2;
-    for (auto y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    for (auto y = 0; y < _tileIndex.GetMapSize().y; y++)
     {
         auto existingTileElement = MapGetSurfaceElementAt(TileCoordsXY{ x - 1, y });
         auto newTileElement = MapGetSurfaceElementAt(TileCoordsXY{ x, y });
@@ -1497,7 +1576,7 @@ static void ClearElementAt(const CoordsXY& loc, TileElement** elementPtr)
             // If asking nicely did not work, forcibly remove this to avoid an infinite loop.
             if (result.Error != GameActions::Status::Ok)
             {
-                TileElementRemove(element);
+                TileElementRemove(loc, element);
             }
             break;
         }
@@ -1509,7 +1588,7 @@ static void ClearElementAt(const CoordsXY& loc, TileElement** elementPtr)
             // If asking nicely did not work, forcibly remove this to avoid an infinite loop.
             if (result.Error != GameActions::Status::Ok)
             {
-                TileElementRemove(element);
+                TileElementRemove(loc, element);
             }
         }
         break;
@@ -1521,7 +1600,7 @@ static void ClearElementAt(const CoordsXY& loc, TileElement** elementPtr)
             // If asking nicely did not work, forcibly remove this to avoid an infinite loop.
             if (result.Error != GameActions::Status::Ok)
             {
-                TileElementRemove(element);
+                TileElementRemove(loc, element);
             }
         }
         break;
@@ -1533,12 +1612,12 @@ static void ClearElementAt(const CoordsXY& loc, TileElement** elementPtr)
             // If asking nicely did not work, forcibly remove this to avoid an infinite loop.
             if (result.Error != GameActions::Status::Ok)
             {
-                TileElementRemove(element);
+                TileElementRemove(loc, element);
             }
             break;
         }
         default:
-            TileElementRemove(element);
+            TileElementRemove(loc, element);
             break;
     }
 }
@@ -1790,18 +1869,8 @@ static void MapInvalidateTileUnderZoom(int32_t x, int32_t y, int32_t z0, int32_t
     if (gOpenRCT2Headless)
         return;
 
-    int32_t x1, y1, x2, y2;
-
-    x += 16;
-    y += 16;
-    auto screenCoord = Translate3DTo2D(GetCurrentRotation(), { x, y });
-
-    x1 = screenCoord.x - 32;
-    y1 = screenCoord.y - 32 - z1;
-    x2 = screenCoord.x + 32;
-    y2 = screenCoord.y + 32 - z0;
-
-    ViewportsInvalidate({ { x1, y1 }, { x2, y2 } }, maxZoom);
+    PaintCacheInvalidateTile({ x, y });
+    ViewportsInvalidateTile({ x, y, z0, z1 }, maxZoom);
 }
 
 /**
@@ -1862,6 +1931,7 @@ void MapInvalidateRegion(const CoordsXY& mins, const CoordsXY& maxs)
     bottom += 32;
     top -= 32 + 2080;
 
+    PaintCacheInvalidateRegion(mins, maxs);
     ViewportsInvalidate({ { left, top }, { right, bottom } });
 }
 
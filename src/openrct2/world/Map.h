@@ -137,6 +137,8 @@ extern bool gMapLandRightsUpdateSuccess;
 void ReorganiseTileElements();
 const std::vector<TileElement>& GetTileElements();
 void SetTileElements(std::vector<TileElement>&& tileElements);
+void SetTileElements(std::vector<TileElement>&& tileElements, const TileCoordsXY& layoutSize);
+void MapResizeTileElements(const TileCoordsXY& mapSize);
 void StashMap();
 void UnstashMap();
 std::vector<TileElement> GetReorganisedTileElementsWithoutGhosts();
@@ -181,7 +183,7 @@ bool MapCheckCapacityAndReorganise(const CoordsXY& loc, size_t numElements = 1);
 int16_t TileElementHeight(const CoordsXY& loc);
 int16_t TileElementHeight(const CoordsXYZ& loc, uint8_t slope);
 int16_t TileElementWaterHeight(const CoordsXY& loc);
-void TileElementRemove(TileElement* tileElement);
+void TileElementRemove(const CoordsXY& loc, TileElement* tileElement);
 TileElement* TileElementInsert(const CoordsXYZ& loc, int32_t occupiedQuadrants, TileElementType type);
 
 template<typename T = TileElement> T* MapGetFirstTileElementWithBaseHeightBetween(const TileCoordsXYRangedZ& loc)
@@ -29,43 +29,82 @@
 #include "Map.h"
 #include "Scenery.h"
 
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
 using namespace OpenRCT2;
 
 using map_animation_invalidate_event_handler = bool (*)(const CoordsXYZ& loc);
 
-static std::vector<MapAnimation> _mapAnimations;
+// Animations are bucketed by chunks of tiles, so the chunks that can not be seen in any viewport can be skipped.
+static constexpr int32_t kChunkSize = 8;
+static constexpr int32_t kNumChunksPerSide = (MAXIMUM_MAP_SIZE_TECHNICAL + kChunkSize - 1) / kChunkSize;
+// Height above the base of an animation that its images can reach.
+static constexpr int32_t kMaxAnimationHeight = 128;
 
-constexpr size_t MAX_ANIMATED_OBJECTS = 2000;
+static std::vector<std::vector<MapAnimation>> _mapAnimationChunks(kNumChunksPerSide * kNumChunksPerSide);
+static std::unordered_set<uint64_t> _mapAnimationKeys;
 
 static bool InvalidateMapAnimation(const MapAnimation& obj);
 
-static bool DoesAnimationExist(int32_t type, const CoordsXYZ& location)
+static uint64_t GetAnimationKey(int32_t type, const CoordsXYZ& location)
+{
+    const TileCoordsXYZ tileLoc{ location };
+    return (static_cast<uint64_t>(static_cast<uint8_t>(type)) << 48)
+        | (static_cast<uint64_t>(static_cast<uint16_t>(tileLoc.x)) << 32)
+        | (static_cast<uint64_t>(static_cast<uint16_t>(tileLoc.y)) << 16) | static_cast<uint16_t>(tileLoc.z);
+}
+
+static std::vector<MapAnimation>* GetAnimationChunk(const CoordsXY& location)
+{
+    const TileCoordsXY tileLoc{ location };
+    if (tileLoc.x < 0 || tileLoc.y < 0 || tileLoc.x >= MAXIMUM_MAP_SIZE_TECHNICAL || tileLoc.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return nullptr;
+    return &_mapAnimationChunks[(tileLoc.y / kChunkSize) * kNumChunksPerSide + (tileLoc.x / kChunkSize)];
+}
+
+void MapAnimationCreate(int32_t type, const CoordsXYZ& loc)
 {
-    for (const auto& a : _mapAnimations)
+    auto* chunk = GetAnimationChunk(loc);
+    if (chunk == nullptr)
+        return;
+
+    if (_mapAnimationKeys.insert(GetAnimationKey(type, loc)).second)
     {
-        if (a.type == type && a.location == location)
-        {
-            // Animation already exists
+        chunk->push_back({ static_cast<uint8_t>(type), loc });
+    }
+}
+
+/**
+ * Animations that change the game state must be updated even when they can not be seen.
+ */
+static bool MapAnimationHasSideEffects(uint8_t type)
+{
+    switch (type)
+    {
+        case MAP_ANIMATION_TYPE_SMALL_SCENERY:
+        case MAP_ANIMATION_TYPE_TRACK_ONRIDEPHOTO:
+        case MAP_ANIMATION_TYPE_WALL_DOOR:
             return true;
-        }
+        default:
+            return false;
     }
-    return false;
 }
 
-void MapAnimationCreate(int32_t type, const CoordsXYZ& loc)
+static bool IsAnimationChunkVisible(size_t chunkIndex, const std::vector<MapAnimation>& chunk)
 {
-    if (!DoesAnimationExist(type, loc))
+    const auto chunkX = static_cast<int32_t>(chunkIndex % kNumChunksPerSide);
+    const auto chunkY = static_cast<int32_t>(chunkIndex / kNumChunksPerSide);
+    const auto mins = TileCoordsXY{ chunkX * kChunkSize, chunkY * kChunkSize }.ToCoordsXY();
+    const auto maxs = TileCoordsXY{ (chunkX + 1) * kChunkSize, (chunkY + 1) * kChunkSize }.ToCoordsXY();
+
+    int32_t maxZ = 0;
+    for (const auto& animation : chunk)
     {
-        if (_mapAnimations.size() < MAX_ANIMATED_OBJECTS)
-        {
-            // Create new animation
-            _mapAnimations.push_back({ static_cast<uint8_t>(type), loc });
-        }
-        else
-        {
-            LOG_ERROR("Exceeded the maximum number of animations");
-        }
+        maxZ = std::max(maxZ, animation.location.z);
     }
+    return ViewportsIsMapAreaVisible(mins, maxs, maxZ + kMaxAnimationHeight);
 }
 
 /**
@@ -76,17 +115,29 @@ void MapAnimationInvalidateAll()
 {
     PROFILED_FUNCTION();
 
-    auto it = _mapAnimations.begin();
-    while (it != _mapAnimations.end())
+    for (size_t chunkIndex = 0; chunkIndex < _mapAnimationChunks.size(); chunkIndex++)
     {
-        if (InvalidateMapAnimation(*it))
-        {
-            // Map animation has finished, remove it
-            it = _mapAnimations.erase(it);
-        }
-        else
+        auto& chunk = _mapAnimationChunks[chunkIndex];
+        if (chunk.empty())
+            continue;
+
+        const bool isVisible = IsAnimationChunkVisible(chunkIndex, chunk);
+        size_t i = 0;
+        while (i < chunk.size())
         {
-            it++;
+            // Copied as the handler may create new animations in this chunk
+            const auto animation = chunk[i];
+            if ((isVisible || MapAnimationHasSideEffects(animation.type)) && InvalidateMapAnimation(animation))
+            {
+                // Map animation has finished, remove it
+                _mapAnimationKeys.erase(GetAnimationKey(animation.type, animation.location));
+                chunk[i] = chunk.back();
+                chunk.pop_back();
+            }
+            else
+            {
+                i++;
+            }
         }
     }
 }
@@ -595,14 +646,13 @@ static bool InvalidateMapAnimation(const MapAnimation& a)
     return true;
 }
 
-const std::vector<MapAnimation>& GetMapAnimations()
-{
-    return _mapAnimations;
-}
-
 static void ClearMapAnimations()
 {
-    _mapAnimations.clear();
+    for (auto& chunk : _mapAnimationChunks)
+    {
+        chunk.clear();
+    }
+    _mapAnimationKeys.clear();
 }
 
 void MapAnimationAutoCreate()
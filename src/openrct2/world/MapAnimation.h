@@ -12,7 +12,6 @@
 #include "Location.hpp"
 
 #include <cstdint>
-#include <vector>
 
 struct TileElement;
 
@@ -43,6 +42,5 @@ enum
 
 void MapAnimationCreate(int32_t type, const CoordsXYZ& loc);
 void MapAnimationInvalidateAll();
-const std::vector<MapAnimation>& GetMapAnimations();
 void MapAnimationAutoCreate();
 void MapAnimationAutoCreateAtTileElement(TileCoordsXY coords, TileElement* el);
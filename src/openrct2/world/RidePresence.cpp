@@ -0,0 +1,140 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "RidePresence.h"
+
+#include "../GameState.h"
+#include "Map.h"
+#include "TileElementsView.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace OpenRCT2;
+
+static constexpr int32_t kRidePresenceCellCount = (MAXIMUM_MAP_SIZE_TECHNICAL + kRidePresenceCellSize - 1)
+    / kRidePresenceCellSize;
+static_assert(kRidePresenceCellSize * kRidePresenceCellSize == 64);
+
+// One bit per tile, set when the tile may contain a track element.
+static std::array<uint64_t, kRidePresenceCellCount * kRidePresenceCellCount> _ridePresenceCells;
+static bool _ridePresenceRebuildRequired = true;
+
+static bool IsTileIndexed(const TileCoordsXY& tilePos)
+{
+    return tilePos.x >= 0 && tilePos.y >= 0 && tilePos.x < MAXIMUM_MAP_SIZE_TECHNICAL
+        && tilePos.y < MAXIMUM_MAP_SIZE_TECHNICAL;
+}
+
+static uint64_t& GetCell(const TileCoordsXY& tilePos)
+{
+    const auto cellX = tilePos.x / kRidePresenceCellSize;
+    const auto cellY = tilePos.y / kRidePresenceCellSize;
+    return _ridePresenceCells[cellY * kRidePresenceCellCount + cellX];
+}
+
+static uint64_t GetTileBit(const TileCoordsXY& tilePos)
+{
+    const auto offsetX = tilePos.x % kRidePresenceCellSize;
+    const auto offsetY = tilePos.y % kRidePresenceCellSize;
+    return uint64_t{ 1 } << (offsetY * kRidePresenceCellSize + offsetX);
+}
+
+static void RidePresenceRebuild()
+{
+    _ridePresenceCells.fill(0);
+    _ridePresenceRebuildRequired = false;
+
+    const auto& mapSize = GetGameState().MapSize;
+    const auto sizeX = std::min(mapSize.x, MAXIMUM_MAP_SIZE_TECHNICAL);
+    const auto sizeY = std::min(mapSize.y, MAXIMUM_MAP_SIZE_TECHNICAL);
+    for (int32_t y = 0; y < sizeY; y++)
+    {
+        for (int32_t x = 0; x < sizeX; x++)
+        {
+            const TileCoordsXY tilePos{ x, y };
+            auto view = TileElementsView<TrackElement>(tilePos);
+            if (view.begin() != view.end())
+            {
+                GetCell(tilePos) |= GetTileBit(tilePos);
+            }
+        }
+    }
+}
+
+void RidePresenceMarkTile(const TileCoordsXY& tilePos)
+{
+    if (!IsTileIndexed(tilePos))
+        return;
+
+    GetCell(tilePos) |= GetTileBit(tilePos);
+}
+
+void RidePresenceInvalidateAll()
+{
+    _ridePresenceRebuildRequired = true;
+}
+
+void RidePresenceGetRidesInRange(
+    const TileCoordsXY& min, const TileCoordsXY& max, BitSet<Limits::MaxRidesInPark>& rides)
+{
+    if (_ridePresenceRebuildRequired)
+    {
+        RidePresenceRebuild();
+    }
+
+    const auto minX = std::max(min.x, 0);
+    const auto minY = std::max(min.y, 0);
+    const auto maxX = std::min(max.x, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    const auto maxY = std::min(max.y, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    if (minX > maxX || minY > maxY)
+        return;
+
+    for (int32_t cellY = minY / kRidePresenceCellSize; cellY <= maxY / kRidePresenceCellSize; cellY++)
+    {
+        for (int32_t cellX = minX / kRidePresenceCellSize; cellX <= maxX / kRidePresenceCellSize; cellX++)
+        {
+            auto& cell = _ridePresenceCells[cellY * kRidePresenceCellCount + cellX];
+            if (cell == 0)
+                continue;
+
+            const auto startX = std::max(minX, cellX * kRidePresenceCellSize);
+            const auto endX = std::min(maxX, cellX * kRidePresenceCellSize + kRidePresenceCellSize - 1);
+            const auto startY = std::max(minY, cellY * kRidePresenceCellSize);
+            const auto endY = std::min(maxY, cellY * kRidePresenceCellSize + kRidePresenceCellSize - 1);
+            for (int32_t y = startY; y <= endY; y++)
+            {
+                for (int32_t x = startX; x <= endX; x++)
+                {
+                    const TileCoordsXY tilePos{ x, y };
+                    const auto bit = GetTileBit(tilePos);
+                    if (!(cell & bit))
+                        continue;
+
+                    bool hasTrack = false;
+                    for (auto* trackElement : TileElementsView<TrackElement>(tilePos))
+                    {
+                        hasTrack = true;
+                        auto rideIndex = trackElement->GetRideIndex();
+                        if (!rideIndex.IsNull())
+                        {
+                            rides[rideIndex.ToUnderlying()] = true;
+                        }
+                    }
+
+                    // The track has been removed since the tile was marked.
+                    if (!hasTrack)
+                    {
+                        cell &= ~bit;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,34 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../Limits.h"
+#include "../core/BitSet.hpp"
+#include "Location.hpp"
+
+// The index is split into cells of 8x8 tiles so a single 64-bit mask covers a cell.
+constexpr int32_t kRidePresenceCellSize = 8;
+
+/**
+ * Marks a tile as possibly containing track. Must be called whenever a track element may have been added to a tile,
+ * tiles that no longer contain track are dropped from the index the next time they are queried.
+ */
+void RidePresenceMarkTile(const TileCoordsXY& tilePos);
+
+/**
+ * Discards the index, it will be rebuilt from the tile elements on the next query.
+ */
+void RidePresenceInvalidateAll();
+
+/**
+ * Sets the bit of every ride that has a track element within the given inclusive tile range.
+ */
+void RidePresenceGetRidesInRange(
+    const TileCoordsXY& min, const TileCoordsXY& max, OpenRCT2::BitSet<OpenRCT2::Limits::MaxRidesInPark>& rides);
@@ -56,7 +56,7 @@ struct TileElementBase
     uint8_t ClearanceHeight; // 3
     uint8_t Owner;           // 4
 
-    void Remove();
+    void Remove(const CoordsXY& loc);
 
     TileElementType GetType() const;
     void SetType(TileElementType newType);
@@ -80,9 +80,9 @@ void TileElementBase::SetGhost(bool isGhost)
     }
 }
 
-void TileElementBase::Remove()
+void TileElementBase::Remove(const CoordsXY& loc)
 {
-    TileElementRemove(static_cast<TileElement*>(this));
+    TileElementRemove(loc, static_cast<TileElement*>(this));
 }
 
 uint8_t TileElementBase::GetOccupiedQuadrants() const
@@ -31,6 +31,7 @@
 #include "Park.h"
 #include "Scenery.h"
 #include "Surface.h"
+#include "TileSummary.h"
 
 #include <algorithm>
 #include <optional>
@@ -160,7 +161,7 @@ namespace OpenRCT2::TileInspector
                 tileElement->RemoveBannerEntry();
             }
 
-            TileElementRemove(tileElement);
+            TileElementRemove(loc, tileElement);
 
             if (IsTileSelected(loc))
             {
@@ -610,6 +611,7 @@ namespace OpenRCT2::TileInspector
         if (isExecuting)
         {
             pathElement->AsPath()->SetIsBroken(broken);
+            TileSummaryInvalidateTile(loc);
         }
 
         return GameActions::Result();
@@ -18,20 +18,25 @@
 template<typename T> class TilePointerIndex
 {
     std::vector<T*> TilePointers;
-    uint16_t MapSize{};
+    TileCoordsXY MapSize{};
 
 public:
     TilePointerIndex() = default;
 
     explicit TilePointerIndex(const uint16_t mapSize, T* tileElements, size_t count)
+        : TilePointerIndex(TileCoordsXY{ mapSize, mapSize }, tileElements, count)
+    {
+    }
+
+    explicit TilePointerIndex(const TileCoordsXY& mapSize, T* tileElements, size_t count)
     {
         MapSize = mapSize;
-        TilePointers.reserve(MapSize * MapSize);
+        TilePointers.reserve(MapSize.x * MapSize.y);
 
         size_t index = 0;
-        for (size_t y = 0; y < MapSize; y++)
+        for (int32_t y = 0; y < MapSize.y; y++)
         {
-            for (size_t x = 0; x < MapSize; x++)
+            for (int32_t x = 0; x < MapSize.x; x++)
             {
                 assert(index < count);
                 TilePointers.emplace_back(&tileElements[index]);
@@ -43,13 +48,23 @@ public:
         }
     }
 
+    const TileCoordsXY& GetMapSize() const
+    {
+        return MapSize;
+    }
+
+    bool IsInRange(TileCoordsXY coords) const
+    {
+        return coords.x >= 0 && coords.y >= 0 && coords.x < MapSize.x && coords.y < MapSize.y;
+    }
+
     T* GetFirstElementAt(TileCoordsXY coords)
     {
-        return TilePointers[coords.x + (coords.y * MapSize)];
+        return TilePointers[coords.x + (coords.y * MapSize.x)];
     }
 
     void SetTile(TileCoordsXY coords, T* tileElement)
     {
-        TilePointers[coords.x + (coords.y * MapSize)] = tileElement;
+        TilePointers[coords.x + (coords.y * MapSize.x)] = tileElement;
     }
 };
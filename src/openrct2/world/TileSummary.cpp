@@ -0,0 +1,137 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TileSummary.h"
+
+#include "../GameState.h"
+#include "../object/PathAdditionEntry.h"
+#include "Map.h"
+#include "TileElementsView.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static std::vector<TileSummary> _tileSummaries;
+static TileCoordsXY _tileSummarySize;
+static bool _tileSummaryResetRequired = true;
+
+static void TileSummaryReset(const TileCoordsXY& size)
+{
+    _tileSummarySize = size;
+    _tileSummaries.assign(static_cast<size_t>(size.x) * size.y, TileSummary{ 0, 0, 0, TILE_SUMMARY_FLAG_DIRTY });
+    _tileSummaryResetRequired = false;
+}
+
+static TileCoordsXY GetTileSummarySize()
+{
+    const auto& mapSize = GetGameState().MapSize;
+    return { std::clamp(mapSize.x, 0, MAXIMUM_MAP_SIZE_TECHNICAL), std::clamp(mapSize.y, 0, MAXIMUM_MAP_SIZE_TECHNICAL) };
+}
+
+static bool IsTileSummarised(const TileCoordsXY& tilePos)
+{
+    return tilePos.x >= 0 && tilePos.y >= 0 && tilePos.x < _tileSummarySize.x && tilePos.y < _tileSummarySize.y;
+}
+
+static void SaturatingIncrement(uint8_t& value)
+{
+    if (value != UINT8_MAX)
+        value++;
+}
+
+static void TileSummaryCount(const TileCoordsXY& tilePos, TileSummary& summary)
+{
+    summary = {};
+    for (auto* tileElement : TileElementsView(tilePos))
+    {
+        if (tileElement->IsGhost())
+            continue;
+
+        switch (tileElement->GetType())
+        {
+            case TileElementType::Path:
+            {
+                auto* pathElement = tileElement->AsPath();
+                if (!pathElement->HasAddition())
+                    break;
+
+                auto* pathAddEntry = pathElement->GetAdditionEntry();
+                if (pathAddEntry == nullptr)
+                {
+                    summary.Flags |= TILE_SUMMARY_FLAG_INVALID_PATH_ADDITION;
+                    break;
+                }
+                if (pathElement->AdditionIsGhost())
+                    break;
+
+                if (pathAddEntry->flags
+                    & (PATH_ADDITION_FLAG_JUMPING_FOUNTAIN_WATER | PATH_ADDITION_FLAG_JUMPING_FOUNTAIN_SNOW))
+                {
+                    SaturatingIncrement(summary.Fountains);
+                    break;
+                }
+                if (pathElement->IsBroken())
+                {
+                    SaturatingIncrement(summary.BrokenPaths);
+                }
+                break;
+            }
+            case TileElementType::LargeScenery:
+            case TileElementType::SmallScenery:
+                SaturatingIncrement(summary.Scenery);
+                break;
+            case TileElementType::Track:
+                summary.Flags |= TILE_SUMMARY_FLAG_HAS_TRACK;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+const TileSummary& TileSummaryGet(const TileCoordsXY& tilePos)
+{
+    static const TileSummary emptySummary{};
+
+    const auto size = GetTileSummarySize();
+    if (_tileSummaryResetRequired || size != _tileSummarySize)
+    {
+        TileSummaryReset(size);
+    }
+
+    if (!IsTileSummarised(tilePos))
+        return emptySummary;
+
+    auto& summary = _tileSummaries[tilePos.y * _tileSummarySize.x + tilePos.x];
+    if (summary.Flags & TILE_SUMMARY_FLAG_DIRTY)
+    {
+        TileSummaryCount(tilePos, summary);
+    }
+    return summary;
+}
+
+void TileSummaryInvalidateTile(const TileCoordsXY& tilePos)
+{
+    if (_tileSummaryResetRequired || !IsTileSummarised(tilePos))
+        return;
+
+    _tileSummaries[tilePos.y * _tileSummarySize.x + tilePos.x].Flags |= TILE_SUMMARY_FLAG_DIRTY;
+}
+
+void TileSummaryInvalidateTile(const CoordsXY& loc)
+{
+    TileSummaryInvalidateTile(TileCoordsXY{ loc });
+}
+
+void TileSummaryInvalidateAll()
+{
+    _tileSummaryResetRequired = true;
+}
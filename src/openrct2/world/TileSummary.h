@@ -0,0 +1,50 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Location.hpp"
+
+#include <cstdint>
+
+enum : uint8_t
+{
+    TILE_SUMMARY_FLAG_HAS_TRACK = (1 << 0),
+    TILE_SUMMARY_FLAG_INVALID_PATH_ADDITION = (1 << 1),
+    TILE_SUMMARY_FLAG_DIRTY = (1 << 7),
+};
+
+/**
+ * Counts of the non-ghost elements on a tile that guests take notice of when assessing their surroundings.
+ * Counts saturate at 255 which is well above any threshold they are compared with.
+ */
+struct TileSummary
+{
+    uint8_t Scenery{};
+    uint8_t Fountains{};
+    uint8_t BrokenPaths{};
+    uint8_t Flags{};
+};
+
+/**
+ * Returns the summary of the given tile, recounting it first if it has been invalidated.
+ */
+const TileSummary& TileSummaryGet(const TileCoordsXY& tilePos);
+
+/**
+ * Must be called whenever scenery, path additions or track on a tile are changed in place. Inserting or removing
+ * elements through TileElementInsert and TileElementRemove invalidates the tile already.
+ */
+void TileSummaryInvalidateTile(const TileCoordsXY& tilePos);
+void TileSummaryInvalidateTile(const CoordsXY& loc);
+
+/**
+ * Invalidates every tile, used when all tile elements are replaced or the loaded objects change.
+ */
+void TileSummaryInvalidateAll();
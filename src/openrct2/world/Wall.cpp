@@ -38,7 +38,7 @@ void WallRemoveAt(const CoordsXYRangedZ& wallPos)
     {
         reinterpret_cast<TileElement*>(wallElement)->RemoveBannerEntry();
         MapInvalidateTileZoom1({ wallPos, wallElement->GetBaseZ(), wallElement->GetBaseZ() + 72 });
-        TileElementRemove(reinterpret_cast<TileElement*>(wallElement));
+        TileElementRemove(wallPos, reinterpret_cast<TileElement*>(wallElement));
     }
 }
 
@@ -75,7 +75,7 @@ void WallRemoveIntersectingWalls(const CoordsXYRangedZ& wallPos, Direction direc
 
         tileElement->RemoveBannerEntry();
         MapInvalidateTileZoom1({ wallPos, tileElement->GetBaseZ(), tileElement->GetBaseZ() + 72 });
-        TileElementRemove(tileElement);
+        TileElementRemove(wallPos, tileElement);
         tileElement--;
     } while (!(tileElement++)->IsLastForTile());
 }
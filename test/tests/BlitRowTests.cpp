@@ -0,0 +1,111 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/util/Util.h>
+#include <random>
+#include <vector>
+
+using BlitRowFunc = void (*)(const uint8_t*, uint8_t*, int32_t, const PaletteMap&, DrawBlendOp);
+
+static constexpr DrawBlendOp kBlendOps[] = {
+    BLEND_NONE,
+    BLEND_TRANSPARENT,
+    BLEND_TRANSPARENT | BLEND_SRC,
+    BLEND_TRANSPARENT | BLEND_DST,
+    BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST,
+};
+
+class BlitRowTest : public testing::Test
+{
+protected:
+    static constexpr int32_t kMaxRowLength = 300;
+    static constexpr uint16_t kNumMaps = 255;
+
+    std::mt19937 _random{ 1234 };
+    std::vector<uint8_t> _paletteData;
+    std::vector<uint8_t> _src;
+    std::vector<uint8_t> _dst;
+
+    void SetUp() override
+    {
+        // Sprinkle zeros into the map and the source so both transparency checks are exercised
+        _paletteData.resize(kNumMaps * 256);
+        for (auto& colour : _paletteData)
+        {
+            colour = RandomColour();
+        }
+        _src.resize(kMaxRowLength);
+        _dst.resize(kMaxRowLength);
+        for (int32_t i = 0; i < kMaxRowLength; i++)
+        {
+            _src[i] = RandomColour();
+            _dst[i] = static_cast<uint8_t>(_random());
+        }
+    }
+
+    uint8_t RandomColour()
+    {
+        auto value = static_cast<uint8_t>(_random());
+        return (value % 4 == 0) ? 0 : value;
+    }
+
+    // Compares every row length and alignment up to kMaxRowLength against BlitRowScalar.
+    void CompareWithScalar(BlitRowFunc blitRow)
+    {
+        PaletteMap paletteMap(_paletteData.data(), kNumMaps, 256);
+        for (auto blendOp : kBlendOps)
+        {
+            for (int32_t offset = 0; offset < 4; offset++)
+            {
+                for (int32_t count = 0; count <= kMaxRowLength - offset; count++)
+                {
+                    auto expected = _dst;
+                    auto actual = _dst;
+                    BlitRowScalar(_src.data() + offset, expected.data() + offset, count, paletteMap, blendOp);
+                    blitRow(_src.data() + offset, actual.data() + offset, count, paletteMap, blendOp);
+                    ASSERT_EQ(expected, actual) << "blend op " << int32_t{ blendOp } << ", count " << count;
+                }
+            }
+        }
+    }
+};
+
+TEST_F(BlitRowTest, ScalarMatchesBlitPixel)
+{
+    PaletteMap paletteMap(_paletteData.data(), kNumMaps, 256);
+    auto expected = _dst;
+    auto actual = _dst;
+    for (int32_t i = 0; i < kMaxRowLength; i++)
+    {
+        BlitPixel<BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST>(&_src[i], &expected[i], paletteMap);
+    }
+    BlitRowScalar(_src.data(), actual.data(), kMaxRowLength, paletteMap, BLEND_TRANSPARENT | BLEND_SRC | BLEND_DST);
+    ASSERT_EQ(expected, actual);
+}
+
+TEST_F(BlitRowTest, Sse4_1MatchesScalar)
+{
+    if (!SSE41Available())
+    {
+        GTEST_SKIP() << "SSE4.1 is not available";
+    }
+    CompareWithScalar(BlitRowSse4_1);
+}
+
+TEST_F(BlitRowTest, Avx2MatchesScalar)
+{
+    if (!AVX2Available())
+    {
+        GTEST_SKIP() << "AVX2 is not available";
+    }
+    CompareWithScalar(BlitRowAvx2);
+}
@@ -0,0 +1,108 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/entity/EntityList.h>
+#include <openrct2/entity/EntityRegistry.h>
+#include <openrct2/entity/Litter.h>
+#include <vector>
+
+using namespace OpenRCT2;
+
+class EntityListTests : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+    }
+
+    static void TearDownTestCase()
+    {
+        if (_context)
+            _context.reset();
+    }
+
+    void SetUp() override
+    {
+        ResetAllEntities();
+        for (auto id : { 10, 20, 30 })
+        {
+            ASSERT_NE(CreateEntityAt<Litter>(EntityId::FromUnderlying(id)), nullptr);
+        }
+    }
+
+    // Iterates the litter list, calling onVisit for each litter, and returns the ids visited.
+    template<typename TFunc> static std::vector<int32_t> Visit(TFunc onVisit)
+    {
+        std::vector<int32_t> visited;
+        for (auto* litter : EntityList<Litter>())
+        {
+            visited.push_back(litter->Id.ToUnderlying());
+            onVisit(litter->Id.ToUnderlying());
+        }
+        return visited;
+    }
+
+private:
+    static std::shared_ptr<IContext> _context;
+};
+
+std::shared_ptr<IContext> EntityListTests::_context;
+
+TEST_F(EntityListTests, IdCreatedBeforeNextIsNotVisited)
+{
+    auto visited = Visit([](int32_t id) {
+        if (id == 10)
+            CreateEntityAt<Litter>(EntityId::FromUnderlying(15));
+    });
+    ASSERT_EQ(visited, (std::vector<int32_t>{ 10, 20, 30 }));
+
+    // It is visited in the next pass
+    visited = Visit([](int32_t) {});
+    ASSERT_EQ(visited, (std::vector<int32_t>{ 10, 15, 20, 30 }));
+}
+
+TEST_F(EntityListTests, IdCreatedAfterNextIsVisited)
+{
+    auto visited = Visit([](int32_t id) {
+        if (id == 10)
+            CreateEntityAt<Litter>(EntityId::FromUnderlying(25));
+    });
+    ASSERT_EQ(visited, (std::vector<int32_t>{ 10, 20, 25, 30 }));
+}
+
+TEST_F(EntityListTests, IdCreatedAfterLastIsNotVisited)
+{
+    auto visited = Visit([](int32_t id) {
+        if (id == 30)
+            CreateEntityAt<Litter>(EntityId::FromUnderlying(40));
+    });
+    ASSERT_EQ(visited, (std::vector<int32_t>{ 10, 20, 30 }));
+}
+
+TEST_F(EntityListTests, RemovedIdsAreNotVisited)
+{
+    auto visited = Visit([](int32_t id) {
+        if (id == 10)
+        {
+            // Remove both the current and the next entity
+            EntityRemove(GetEntity(EntityId::FromUnderlying(10)));
+            EntityRemove(GetEntity(EntityId::FromUnderlying(20)));
+        }
+    });
+    ASSERT_EQ(visited, (std::vector<int32_t>{ 10, 30 }));
+}
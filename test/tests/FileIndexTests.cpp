@@ -0,0 +1,124 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <openrct2/core/File.h>
+#include <openrct2/core/FileIndex.hpp>
+#include <openrct2/core/Path.hpp>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+class TextFileIndex final : public FileIndex<std::string>
+{
+public:
+    mutable std::atomic<size_t> NumCreated = 0;
+
+    explicit TextFileIndex(const std::string& directory)
+        : FileIndex(
+            "text index", 0x58444954, 1, Path::Combine(directory, u8"index.idx"), "*.txt",
+            std::vector<std::string>({ directory }))
+    {
+    }
+
+protected:
+    std::optional<std::string> Create(int32_t, const std::string& path) const override
+    {
+        NumCreated++;
+        auto text = File::ReadAllText(path);
+        if (text.empty())
+        {
+            return std::nullopt;
+        }
+        return text;
+    }
+
+    void Serialise(DataSerialiser& ds, const std::string& item) const override
+    {
+        ds << item;
+    }
+};
+
+class FileIndexTest : public testing::Test
+{
+protected:
+    std::string _directory;
+
+    void SetUp() override
+    {
+        auto name = std::string("openrct2-fileindex-") + testing::UnitTest::GetInstance()->current_test_info()->name();
+        _directory = (fs::temp_directory_path() / name).u8string();
+        fs::remove_all(_directory);
+        fs::create_directories(_directory);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(_directory);
+    }
+
+    void WriteFile(const std::string& name, const std::string& text)
+    {
+        File::WriteAllBytes(Path::Combine(_directory, name), text.data(), text.size());
+    }
+
+    static std::vector<std::string> Sorted(std::vector<std::string> items)
+    {
+        std::sort(items.begin(), items.end());
+        return items;
+    }
+};
+
+TEST_F(FileIndexTest, UnchangedFilesAreNotReloaded)
+{
+    WriteFile("a.txt", "alpha");
+    WriteFile("b.txt", "beta");
+    WriteFile("empty.txt", "");
+
+    TextFileIndex index(_directory);
+    ASSERT_EQ(Sorted(index.LoadOrBuild(0)), (std::vector<std::string>{ "alpha", "beta" }));
+    ASSERT_EQ(index.NumCreated, 3u);
+
+    // Files without an item are remembered as well
+    index.NumCreated = 0;
+    ASSERT_EQ(Sorted(index.LoadOrBuild(0)), (std::vector<std::string>{ "alpha", "beta" }));
+    ASSERT_EQ(index.NumCreated, 0u);
+}
+
+TEST_F(FileIndexTest, OnlyChangedFilesAreReloaded)
+{
+    WriteFile("a.txt", "alpha");
+    WriteFile("b.txt", "beta");
+    TextFileIndex index(_directory);
+    index.LoadOrBuild(0);
+
+    File::Delete(Path::Combine(_directory, "a.txt"));
+    WriteFile("b.txt", "beta two");
+    WriteFile("c.txt", "gamma");
+
+    index.NumCreated = 0;
+    ASSERT_EQ(Sorted(index.LoadOrBuild(0)), (std::vector<std::string>{ "beta two", "gamma" }));
+    ASSERT_EQ(index.NumCreated, 2u);
+}
+
+TEST_F(FileIndexTest, LanguageChangeReloadsAll)
+{
+    WriteFile("a.txt", "alpha");
+    WriteFile("b.txt", "beta");
+    TextFileIndex index(_directory);
+    index.LoadOrBuild(0);
+
+    index.NumCreated = 0;
+    ASSERT_EQ(Sorted(index.LoadOrBuild(1)), (std::vector<std::string>{ "alpha", "beta" }));
+    ASSERT_EQ(index.NumCreated, 2u);
+}
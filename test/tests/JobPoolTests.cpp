@@ -0,0 +1,55 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <openrct2/core/JobPool.h>
+#include <vector>
+
+TEST(JobPoolTest, ParallelForVisitsEveryIndexOnce)
+{
+    JobPool jobPool;
+
+    for (size_t count : { 0, 1, 7, 1000, 100000 })
+    {
+        std::vector<std::atomic<int>> visits(count);
+        jobPool.ParallelFor(count, [&](size_t i) { visits[i]++; });
+        for (size_t i = 0; i < count; i++)
+        {
+            ASSERT_EQ(visits[i], 1) << "index " << i << " of " << count;
+        }
+    }
+}
+
+TEST(JobPoolTest, ParallelForGrainSize)
+{
+    JobPool jobPool;
+
+    std::atomic<size_t> sum = 0;
+    jobPool.ParallelFor(10000, [&](size_t i) { sum += i; }, 64);
+    ASSERT_EQ(sum, 10000u * 9999u / 2);
+}
+
+TEST(JobPoolTest, NestedParallelFor)
+{
+    JobPool jobPool;
+
+    std::atomic<size_t> calls = 0;
+    jobPool.ParallelFor(64, [&](size_t) { jobPool.ParallelFor(64, [&](size_t) { calls++; }); });
+    ASSERT_EQ(calls, 64u * 64u);
+}
+
+TEST(JobPoolTest, ReportIsCalled)
+{
+    JobPool jobPool;
+
+    size_t reports = 0;
+    jobPool.ParallelFor(16, [](size_t) {}, 1, [&]() { reports++; });
+    ASSERT_GE(reports, 1u);
+}
@@ -0,0 +1,151 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <openrct2/core/MemoryStream.h>
+#include <openrct2/core/OrcaStream.hpp>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static std::vector<uint32_t> CreateChunkData(uint32_t seed, size_t count)
+{
+    std::vector<uint32_t> data(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        // Mix of repeating and varying values so the data neither compresses to nothing nor not at all
+        data[i] = (i % 16 == 0) ? static_cast<uint32_t>(i * 2654435761u) ^ seed : seed;
+    }
+    return data;
+}
+
+static void WriteChunk(OrcaStream& os, uint32_t chunkId, std::vector<uint32_t>& data)
+{
+    os.ReadWriteChunk(chunkId, [&data](OrcaStream::ChunkStream& cs) {
+        cs.ReadWriteVector(data, [&cs](uint32_t& value) { cs.ReadWrite(value); });
+    });
+}
+
+static std::vector<uint32_t> ReadChunk(OrcaStream& os, uint32_t chunkId)
+{
+    std::vector<uint32_t> data;
+    auto found = os.ReadWriteChunk(chunkId, [&data](OrcaStream::ChunkStream& cs) {
+        cs.ReadWriteVector(data, [&cs](uint32_t& value) { cs.ReadWrite(value); });
+    });
+    EXPECT_TRUE(found);
+    return data;
+}
+
+static void WriteTestFile(MemoryStream& ms, uint32_t compression)
+{
+    OrcaStream os(ms, OrcaStream::Mode::WRITING);
+    os.GetHeader().Compression = compression;
+
+    auto small = CreateChunkData(1, 10);
+    auto empty = CreateChunkData(2, 0);
+    auto large = CreateChunkData(3, 1000000);
+    WriteChunk(os, 0x01, small);
+    WriteChunk(os, 0x02, empty);
+    WriteChunk(os, 0x03, large);
+}
+
+TEST(OrcaStreamTest, RoundTrip)
+{
+    for (auto compression :
+         { OrcaStream::COMPRESSION_NONE, OrcaStream::COMPRESSION_GZIP, OrcaStream::COMPRESSION_GZIP_CHUNKED })
+    {
+        MemoryStream ms;
+        WriteTestFile(ms, compression);
+
+        ms.SetPosition(0);
+        OrcaStream os(ms, OrcaStream::Mode::READING);
+        ASSERT_EQ(os.GetHeader().Compression, compression);
+        os.DecompressAllChunks();
+        ASSERT_EQ(ReadChunk(os, 0x03), CreateChunkData(3, 1000000));
+        ASSERT_EQ(ReadChunk(os, 0x01), CreateChunkData(1, 10));
+        ASSERT_EQ(ReadChunk(os, 0x02), CreateChunkData(2, 0));
+        ASSERT_FALSE(os.ReadWriteChunk(0x04, [](OrcaStream::ChunkStream&) {}));
+    }
+}
+
+TEST(OrcaStreamTest, ChunkedReadsSingleChunk)
+{
+    MemoryStream ms;
+    WriteTestFile(ms, OrcaStream::COMPRESSION_GZIP_CHUNKED);
+
+    ms.SetPosition(0);
+    OrcaStream os(ms, OrcaStream::Mode::READING);
+    ASSERT_EQ(ReadChunk(os, 0x01), CreateChunkData(1, 10));
+    ASSERT_EQ(ReadChunk(os, 0x03), CreateChunkData(3, 1000000));
+}
+
+TEST(OrcaStreamTest, ChunkedReadsBlocksOnDemand)
+{
+    MemoryStream ms;
+    WriteTestFile(ms, OrcaStream::COMPRESSION_GZIP_CHUNKED);
+
+    ms.SetPosition(0);
+    OrcaStream os(ms, OrcaStream::Mode::READING);
+    ASSERT_EQ(ReadChunk(os, 0x01), CreateChunkData(1, 10));
+
+    // Chunks that have been read no longer need the stream, the others are still read from it
+    ms.Clear();
+    ASSERT_EQ(ReadChunk(os, 0x01), CreateChunkData(1, 10));
+    ASSERT_THROW(ReadChunk(os, 0x03), IOException);
+}
+
+TEST(OrcaStreamTest, ChunkedReadCompressedData)
+{
+    MemoryStream ms;
+    WriteTestFile(ms, OrcaStream::COMPRESSION_GZIP_CHUNKED);
+
+    ms.SetPosition(0);
+    OrcaStream os(ms, OrcaStream::Mode::READING);
+    os.ReadCompressedData();
+    ms.Clear();
+    ASSERT_EQ(ReadChunk(os, 0x03), CreateChunkData(3, 1000000));
+    ASSERT_EQ(ReadChunk(os, 0x01), CreateChunkData(1, 10));
+}
+
+TEST(OrcaStreamTest, ChunkedChecksumMatchesWholeFile)
+{
+    MemoryStream whole;
+    WriteTestFile(whole, OrcaStream::COMPRESSION_GZIP);
+    MemoryStream chunked;
+    WriteTestFile(chunked, OrcaStream::COMPRESSION_GZIP_CHUNKED);
+
+    whole.SetPosition(0);
+    chunked.SetPosition(0);
+    OrcaStream wholeOs(whole, OrcaStream::Mode::READING);
+    OrcaStream chunkedOs(chunked, OrcaStream::Mode::READING);
+    ASSERT_EQ(wholeOs.GetHeader().UncompressedSize, chunkedOs.GetHeader().UncompressedSize);
+    ASSERT_EQ(wholeOs.GetHeader().FNV1a, chunkedOs.GetHeader().FNV1a);
+}
+
+TEST(OrcaStreamTest, CopyChunksTo)
+{
+    MemoryStream uncompressed;
+    WriteTestFile(uncompressed, OrcaStream::COMPRESSION_NONE);
+
+    MemoryStream copy;
+    {
+        uncompressed.SetPosition(0);
+        OrcaStream src(uncompressed, OrcaStream::Mode::READING);
+        OrcaStream dst(copy, OrcaStream::Mode::WRITING);
+        src.CopyChunksTo(dst);
+    }
+
+    copy.SetPosition(0);
+    OrcaStream os(copy, OrcaStream::Mode::READING);
+    ASSERT_EQ(os.GetHeader().Compression, OrcaStream::COMPRESSION_GZIP_CHUNKED);
+    ASSERT_EQ(ReadChunk(os, 0x01), CreateChunkData(1, 10));
+    ASSERT_EQ(ReadChunk(os, 0x02), CreateChunkData(2, 0));
+    ASSERT_EQ(ReadChunk(os, 0x03), CreateChunkData(3, 1000000));
+}
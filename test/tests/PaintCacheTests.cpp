@@ -0,0 +1,151 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameState.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/config/Config.h>
+#include <openrct2/drawing/LightFX.h>
+#include <openrct2/object/ObjectEntryManager.h>
+#include <openrct2/object/ObjectLimits.h>
+#include <openrct2/object/PathAdditionEntry.h>
+#include <openrct2/paint/Paint.h>
+#include <openrct2/paint/tile_element/Paint.TileElement.h>
+#include <openrct2/world/Footpath.h>
+#include <openrct2/world/Map.h>
+
+using namespace OpenRCT2;
+
+class PaintCacheTests : public testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        std::string parkPath = TestData::GetParkPath("tile-element-tests.sv6");
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        GetContext()->LoadParkFromFile(parkPath);
+        GameLoadInit();
+        SUCCEED();
+    }
+
+    static void TearDownTestCase()
+    {
+        if (_context)
+            _context.reset();
+    }
+
+    void SetUp() override
+    {
+        _enableLightFx = gConfigGeneral.EnableLightFx;
+        gConfigGeneral.EnableLightFx = true;
+        LightFXSetAvailable(true);
+        LightFXInit();
+    }
+
+    void TearDown() override
+    {
+        LightFXSetAvailable(false);
+        gConfigGeneral.EnableLightFx = _enableLightFx;
+    }
+
+    // Paints the tile on its own and returns the map lights it added.
+    static std::vector<LightFXMapLight> PaintTileLights(const CoordsXYZ& pos)
+    {
+        const auto screenPos = Translate3DTo2DWithZ(0, pos + CoordsXYZ{ 16, 16, 0 });
+        DrawPixelInfo dpi{};
+        dpi.x = screenPos.x - 128;
+        dpi.y = screenPos.y - 128;
+        dpi.width = 256;
+        dpi.height = 256;
+
+        auto* session = PaintSessionAlloc(dpi, 0);
+        session->CurrentRotation = 0;
+        TileElementPaintSetup(*session, pos);
+        PaintSessionFree(session);
+
+        LightFXSwapBuffers();
+        return LightFXGetFrontMapLights();
+    }
+
+private:
+    static std::shared_ptr<IContext> _context;
+    bool _enableLightFx{};
+};
+
+std::shared_ptr<IContext> PaintCacheTests::_context;
+
+static PathElement* FindPath(CoordsXY& loc)
+{
+    const auto& mapSize = GetGameState().MapSize;
+    for (int32_t y = 1; y < mapSize.y - 1; y++)
+    {
+        for (int32_t x = 1; x < mapSize.x - 1; x++)
+        {
+            auto* element = MapGetFirstElementAt(TileCoordsXY{ x, y });
+            if (element == nullptr)
+                continue;
+            do
+            {
+                if (element->GetType() == TileElementType::Path)
+                {
+                    loc = TileCoordsXY{ x, y }.ToCoordsXY();
+                    return element->AsPath();
+                }
+            } while (!(element++)->IsLastForTile());
+        }
+    }
+    return nullptr;
+}
+
+static ObjectEntryIndex FindLampEntryIndex()
+{
+    for (ObjectEntryIndex i = 0; i < MAX_PATH_ADDITION_OBJECTS; i++)
+    {
+        const auto* entry = ObjectManager::GetObjectEntry<PathAdditionEntry>(i);
+        if (entry != nullptr && (entry->flags & PATH_ADDITION_FLAG_LAMP))
+            return i;
+    }
+    return OBJECT_ENTRY_INDEX_NULL;
+}
+
+TEST_F(PaintCacheTests, ReplayedTileAddsLights)
+{
+    CoordsXY loc;
+    auto* pathElement = FindPath(loc);
+    ASSERT_NE(pathElement, nullptr);
+    const auto lampIndex = FindLampEntryIndex();
+    if (lampIndex == OBJECT_ENTRY_INDEX_NULL)
+    {
+        GTEST_SKIP() << "No lamp is loaded in the park";
+    }
+
+    // A lamp on a path without edges lights all four sides
+    pathElement->SetAdditionEntryIndex(lampIndex);
+    pathElement->SetAdditionIsGhost(false);
+    pathElement->SetIsBroken(false);
+    pathElement->SetEdges(0);
+
+    const CoordsXYZ pos = { loc, pathElement->GetBaseZ() };
+
+    // The first paint records the tile into the cache, the second replays it
+    const auto recordedLights = PaintTileLights(pos);
+    const auto replayedLights = PaintTileLights(pos);
+    ASSERT_EQ(recordedLights.size(), 4u);
+    ASSERT_EQ(recordedLights, replayedLights);
+}
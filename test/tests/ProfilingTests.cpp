@@ -0,0 +1,61 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <openrct2/core/File.h>
+#include <openrct2/profiling/Profiling.h>
+#include <string>
+#include <thread>
+
+using namespace OpenRCT2;
+
+static void ProfilingTestTracedFunction()
+{
+    PROFILED_FUNCTION();
+}
+
+static size_t CountOccurrences(const std::string& str, const std::string& value)
+{
+    size_t count = 0;
+    for (auto pos = str.find(value); pos != std::string::npos; pos = str.find(value, pos + value.size()))
+    {
+        count++;
+    }
+    return count;
+}
+
+TEST(ProfilingTests, ChromeTraceExport)
+{
+    ProfilingTestTracedFunction();
+
+    // Only calls made while tracing are exported
+    Profiling::StartTrace();
+    ProfilingTestTracedFunction();
+    std::thread thread([]() {
+        for (int32_t i = 0; i < 3; i++)
+        {
+            ProfilingTestTracedFunction();
+        }
+    });
+    thread.join();
+    Profiling::StopTrace();
+    ProfilingTestTracedFunction();
+
+    auto traceFile = (std::filesystem::temp_directory_path() / "openrct2-profiling-trace.json").u8string();
+    ASSERT_TRUE(Profiling::ExportChromeTrace(traceFile));
+
+    auto json = File::ReadAllText(traceFile);
+    File::Delete(traceFile);
+
+    ASSERT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    ASSERT_EQ(CountOccurrences(json, "ProfilingTestTracedFunction"), 4u);
+    ASSERT_EQ(CountOccurrences(json, "\"ph\":\"X\""), 4u);
+    ASSERT_EQ(CountOccurrences(json, "\"tid\":"), 4u);
+}
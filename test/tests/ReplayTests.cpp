@@ -9,17 +9,21 @@
 
 #include "TestData.h"
 
+#include <algorithm>
+#include <filesystem>
 #include <gtest/gtest.h>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
 #include <openrct2/GameState.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ReplayManager.h>
+#include <openrct2/actions/StaffHireNewAction.h>
 #include <openrct2/audio/AudioContext.h>
 #include <openrct2/core/File.h>
 #include <openrct2/core/FileScanner.h>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
+#include <openrct2/entity/EntityList.h>
 #include <openrct2/platform/Platform.h>
 #include <openrct2/ride/Ride.h>
 #include <string>
@@ -115,3 +119,139 @@ struct PrintReplayParameter
 };
 
 INSTANTIATE_TEST_SUITE_P(Replay, ReplayTests, testing::ValuesIn(GetReplayFiles()), PrintReplayParameter());
+
+// Records a replay on the park of an existing replay, with a keyframe every keyframeTicks. A handyman is hired before
+// each of actionTicks is run, so a keyframe on the same tick already contains them.
+static void RecordReplay(
+    IContext& context, const std::string& replayFile, uint32_t ticks, uint32_t keyframeTicks,
+    const std::vector<uint32_t>& actionTicks = {})
+{
+    auto gs = context.GetGameState();
+    IReplayManager* replayManager = context.GetReplayManager();
+
+    ASSERT_TRUE(replayManager->StartPlayback(GetReplayFiles()[0].filePath));
+    ASSERT_TRUE(replayManager->StopPlayback());
+
+    ASSERT_TRUE(replayManager->StartRecording(replayFile, ticks, IReplayManager::RecordType::NORMAL, keyframeTicks));
+    const auto tickStart = GetGameState().CurrentTicks;
+    while (replayManager->IsRecording())
+    {
+        const auto tick = GetGameState().CurrentTicks - tickStart;
+        if (std::find(actionTicks.begin(), actionTicks.end(), tick) != actionTicks.end())
+        {
+            auto action = StaffHireNewAction(true, StaffType::Handyman, EntertainerCostume::Panda, 0);
+            ASSERT_EQ(GameActions::Execute(&action).Error, GameActions::Status::Ok);
+        }
+        gs->UpdateLogic();
+    }
+}
+
+static void PlayUntilEnd(IContext& context)
+{
+    auto gs = context.GetGameState();
+    IReplayManager* replayManager = context.GetReplayManager();
+    while (replayManager->IsReplaying())
+    {
+        gs->UpdateLogic();
+        if (replayManager->IsPlaybackStateMismatching())
+            break;
+    }
+}
+
+TEST(ReplayStreamTests, RecordAndSeek)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    if (GetReplayFiles().empty())
+    {
+        GTEST_SKIP() << "No replays to load a park from";
+    }
+
+    auto context = CreateContext();
+    ASSERT_TRUE(context->Initialise());
+    auto gs = context->GetGameState();
+    IReplayManager* replayManager = context->GetReplayManager();
+
+    // Keyframes are written at ticks 0, 100, 200 and 300 of the replay. Each action hires a handyman, the one on tick
+    // 100 is executed before the keyframe of that tick is taken.
+    auto replayFile = (std::filesystem::temp_directory_path() / "openrct2-replay-seek.parkrep").u8string();
+    ASSERT_NO_FATAL_FAILURE(RecordReplay(*context, replayFile, 300, 100, { 30, 100, 220 }));
+
+    ASSERT_TRUE(replayManager->StartPlayback(replayFile));
+    const auto tickStart = GetGameState().CurrentTicks;
+    const auto staffCount = GetEntityListCount(EntityType::Staff);
+    for (int32_t i = 0; i < 50; i++)
+    {
+        gs->UpdateLogic();
+    }
+    ASSERT_EQ(GetEntityListCount(EntityType::Staff), staffCount + 1);
+
+    // Seeking forward past a keyframe loads it instead of running the ticks before it
+    ASSERT_TRUE(replayManager->SeekPlayback(250));
+    ASSERT_EQ(GetGameState().CurrentTicks, tickStart + 250);
+    ASSERT_EQ(GetEntityListCount(EntityType::Staff), staffCount + 3);
+    ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+
+    // Seeking back loads the last keyframe before the tick, the action of the keyframe tick is not executed again
+    ASSERT_TRUE(replayManager->SeekPlayback(150));
+    ASSERT_EQ(GetGameState().CurrentTicks, tickStart + 150);
+    ASSERT_EQ(GetEntityListCount(EntityType::Staff), staffCount + 2);
+    ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+
+    ASSERT_TRUE(replayManager->SeekPlayback(100));
+    ASSERT_EQ(GetGameState().CurrentTicks, tickStart + 100);
+    ASSERT_EQ(GetEntityListCount(EntityType::Staff), staffCount + 2);
+    PlayUntilEnd(*context);
+    ASSERT_FALSE(replayManager->IsReplaying());
+    ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+    ASSERT_EQ(GetEntityListCount(EntityType::Staff), staffCount + 3);
+
+    // Seeking back before the first periodic keyframe reloads the park the replay started with
+    ASSERT_TRUE(replayManager->StartPlayback(replayFile));
+    ASSERT_TRUE(replayManager->SeekPlayback(250));
+    ASSERT_TRUE(replayManager->SeekPlayback(50));
+    ASSERT_EQ(GetGameState().CurrentTicks, tickStart + 50);
+    ASSERT_EQ(GetEntityListCount(EntityType::Staff), staffCount + 1);
+    PlayUntilEnd(*context);
+    ASSERT_FALSE(replayManager->IsReplaying());
+    ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+
+    File::Delete(replayFile);
+}
+
+TEST(ReplayStreamTests, PlayTruncatedReplay)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    if (GetReplayFiles().empty())
+    {
+        GTEST_SKIP() << "No replays to load a park from";
+    }
+
+    auto context = CreateContext();
+    ASSERT_TRUE(context->Initialise());
+    IReplayManager* replayManager = context->GetReplayManager();
+
+    auto replayFile = (std::filesystem::temp_directory_path() / "openrct2-replay-truncated.parkrep").u8string();
+    ASSERT_NO_FATAL_FAILURE(RecordReplay(*context, replayFile, 300, 100));
+    auto data = File::ReadAllBytes(replayFile);
+    ASSERT_GT(data.size(), 16u);
+
+    // Cut into the last block, the replay plays up to the block before it
+    File::WriteAllBytes(replayFile, data.data(), data.size() - 16);
+    ASSERT_TRUE(replayManager->StartPlayback(replayFile));
+    const auto tickStart = GetGameState().CurrentTicks;
+    ASSERT_TRUE(replayManager->SeekPlayback(250));
+    ASSERT_EQ(GetGameState().CurrentTicks, tickStart + 250);
+    PlayUntilEnd(*context);
+    ASSERT_FALSE(replayManager->IsReplaying());
+    ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+
+    // Without a complete header and first keyframe there is nothing to play
+    File::WriteAllBytes(replayFile, data.data(), 16);
+    ASSERT_FALSE(replayManager->StartPlayback(replayFile));
+
+    File::Delete(replayFile);
+}
@@ -0,0 +1,77 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/core/SpscQueue.hpp>
+#include <thread>
+
+using namespace OpenRCT2;
+
+TEST(SpscQueueTest, PopsInOrder)
+{
+    SpscQueue<int> queue;
+    int value = 0;
+    ASSERT_FALSE(queue.TryPop(value));
+
+    queue.Push(1);
+    queue.Push(2);
+    ASSERT_EQ(queue.GetSize(), 2u);
+    ASSERT_TRUE(queue.TryPop(value));
+    ASSERT_EQ(value, 1);
+    queue.Push(3);
+    ASSERT_TRUE(queue.TryPop(value));
+    ASSERT_EQ(value, 2);
+    ASSERT_TRUE(queue.TryPop(value));
+    ASSERT_EQ(value, 3);
+    ASSERT_FALSE(queue.TryPop(value));
+    ASSERT_EQ(queue.GetSize(), 0u);
+}
+
+TEST(SpscQueueTest, MoveOnlyValues)
+{
+    SpscQueue<std::unique_ptr<int>> queue;
+    queue.Push(std::make_unique<int>(5));
+    queue.Push(std::make_unique<int>(6));
+
+    // Values still queued are released by the destructor
+    std::unique_ptr<int> value;
+    ASSERT_TRUE(queue.TryPop(value));
+    ASSERT_EQ(*value, 5);
+}
+
+TEST(SpscQueueTest, ProducerThread)
+{
+    constexpr int32_t kCount = 100000;
+
+    SpscQueue<int32_t> queue;
+    std::thread producer([&queue]() {
+        for (int32_t i = 0; i < kCount; i++)
+        {
+            queue.Push(int32_t{ i });
+        }
+    });
+
+    int32_t expected = 0;
+    while (expected < kCount)
+    {
+        int32_t value;
+        if (queue.TryPop(value))
+        {
+            ASSERT_EQ(value, expected);
+            expected++;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    ASSERT_EQ(queue.GetSize(), 0u);
+}